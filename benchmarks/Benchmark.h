@@ -0,0 +1,145 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Minimal self-contained benchmark harness.
+ *        A benchmark is a function taking a State, registered with one or more arguments:
+ *            static void BM_Something(bench::State &state) {
+ *                // setup...
+ *                for (auto _: state) { ...measured code... }
+ *                state.setItemsProcessed(state.iterations() * state.arg());
+ *            }
+ *            BENCHMARK(BM_Something, 100, 1000, 10000);
+ *        The runner repeats the loop with growing iteration counts until it ran for the minimum time.
+ */
+namespace bench {
+    using Clock = std::chrono::steady_clock;
+
+    class State {
+    public:
+        State(std::int64_t arg, std::size_t iterations) : argument(arg), count(iterations) {
+        }
+
+        std::int64_t arg() const { return argument; }
+        std::size_t iterations() const { return count; }
+
+        // Excludes setup done inside the loop from the measurement.
+        void pauseTiming() {
+            elapsed += Clock::now() - start;
+            paused = true;
+        }
+
+        void resumeTiming() {
+            paused = false;
+            start = Clock::now();
+        }
+
+        void setItemsProcessed(std::size_t items) { itemsProcessed = items; }
+
+        // Marks the benchmark as not runnable with this argument, call before the loop.
+        void skip(std::string reason) {
+            skipReason = std::move(reason);
+            count = 0;
+        }
+
+        struct Sentinel {
+        };
+
+        class Iterator {
+        public:
+            explicit Iterator(State *state) : state(state) {
+            }
+
+            int operator*() const { return 0; }
+
+            Iterator &operator++() {
+                --state->remaining;
+                return *this;
+            }
+
+            bool operator!=(Sentinel) {
+                if (state->remaining != 0) return true;
+                state->finish();
+                return false;
+            }
+
+        private:
+            State *state;
+        };
+
+        Iterator begin() {
+            remaining = count;
+            elapsed = Clock::duration::zero();
+            paused = false;
+            start = Clock::now();
+            return Iterator(this);
+        }
+
+        Sentinel end() { return {}; }
+
+        double seconds() const { return std::chrono::duration<double>(elapsed).count(); }
+        std::size_t items() const { return itemsProcessed; }
+        bool skipped() const { return !skipReason.empty(); }
+        const std::string &getSkipReason() const { return skipReason; }
+
+    private:
+        std::int64_t argument;
+        std::size_t count;
+        std::size_t remaining = 0;
+        std::size_t itemsProcessed = 0;
+        Clock::time_point start;
+        Clock::duration elapsed = Clock::duration::zero();
+        bool paused = false;
+        std::string skipReason;
+
+        void finish() {
+            if (!paused) elapsed += Clock::now() - start;
+        }
+    };
+
+    using Function = std::function<void(State &)>;
+
+    struct Entry {
+        std::string name;
+        Function function;
+        std::vector<std::int64_t> args;
+    };
+
+    inline std::vector<Entry> &registry() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    struct Registration {
+        Registration(std::string name, Function function, std::initializer_list<std::int64_t> args) {
+            registry().push_back({std::move(name), std::move(function), args});
+        }
+    };
+
+    // Keeps the compiler from optimizing a computed value away.
+    template<typename T>
+    inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T *sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+#define BENCHMARK(function, ...) \
+    static const bench::Registration BENCHMARK_CONCAT(benchmarkRegistration, __LINE__)(#function, function, {__VA_ARGS__})
+
+#endif
@@ -0,0 +1,84 @@
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "GeneratedMap.h"
+#include "Engine/Core/UpdateContext.h"
+#include "Engine/Systems/MovementSystem.h"
+#include "Engine/Systems/PhysicsSystem.h"
+
+namespace {
+    constexpr int MAP_WIDTH = 64;
+    constexpr int MAP_HEIGHT = 48;
+    constexpr float MAP_PIXELS = 16.f * 3.f; // One tile at the map's 3x scale
+
+    // Generated level plus 'bodies' player sized dynamic colliders scattered over it.
+    struct CollisionWorld : GeneratedMap::Level {
+        std::shared_ptr<MovementSystem> movement = systemManager.registerSystem<MovementSystem>();
+        std::shared_ptr<PhysicsSystem> physics = systemManager.registerSystem<PhysicsSystem>();
+        UpdateContext ctxt{};
+
+        explicit CollisionWorld(std::size_t bodies) : Level(MAP_WIDTH, MAP_HEIGHT) {
+            std::mt19937 rng(1);
+            std::uniform_real_distribution<float> x(0.f, MAP_WIDTH * MAP_PIXELS);
+            std::uniform_real_distribution<float> y(0.f, MAP_HEIGHT * MAP_PIXELS);
+            std::uniform_real_distribution<float> speed(-150.f, 150.f);
+
+            for (std::size_t i = 0; i < bodies; ++i) {
+                Entity entity = entityManager.createEntity();
+                ColliderComponent collider;
+                collider.bounds = {-15.f, -36.f, 34.f, 85.f};
+                components.addComponent<ColliderComponent>(entity, collider);
+                components.addComponent<Position>(entity, {x(rng), y(rng)});
+                components.addComponent<Velocity>(entity, {speed(rng), 0.f});
+            }
+            systemManager.sortEntities();
+
+            ctxt.dt = 1.f / 60.f;
+            ctxt.tDt = sf::seconds(ctxt.dt);
+            ctxt.component = &components;
+            ctxt.entity = &entityManager;
+            ctxt.system = &systemManager;
+        }
+    };
+}
+
+// One collision pass over the moving bodies, physics and movement run untimed in between.
+static void BM_CollisionUpdate(bench::State &state) {
+    std::size_t bodies = state.arg();
+
+    CollisionWorld world(bodies);
+    for (auto _: state) {
+        state.pauseTiming();
+        world.physics->update(world.ctxt);
+        world.movement->update(world.ctxt);
+        state.resumeTiming();
+
+        world.collision->update(world.ctxt);
+    }
+    state.setItemsProcessed(state.iterations() * bodies);
+}
+BENCHMARK(BM_CollisionUpdate, 100, 1000, 10000);
+
+// Point queries against the baked solidity grid, as the particle systems do per particle.
+static void BM_IsSolidAt(bench::State &state) {
+    GeneratedMap::Level level(MAP_WIDTH, MAP_HEIGHT);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> x(0.f, MAP_WIDTH * MAP_PIXELS);
+    std::uniform_real_distribution<float> y(0.f, MAP_HEIGHT * MAP_PIXELS);
+    std::vector<sf::Vector2f> points(state.arg());
+    for (sf::Vector2f &point: points) {
+        point = {x(rng), y(rng)};
+    }
+
+    for (auto _: state) {
+        std::size_t solid = 0;
+        for (const sf::Vector2f &point: points) {
+            solid += level.collision->isSolidAt(point.x, point.y);
+        }
+        bench::doNotOptimize(solid);
+    }
+    state.setItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_IsSolidAt, 1000, 100000);
@@ -0,0 +1,135 @@
+#include <memory>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/ComponentManager.h"
+#include "Engine/EntityManager.h"
+#include "Engine/SystemManager.h"
+#include "Engine/Components/Position.h"
+#include "Engine/Components/Velocity.h"
+
+namespace {
+    // Managers with 'count' entities that each own a Position and a Velocity.
+    struct World {
+        EntityManager entityManager;
+        SystemManager systemManager;
+        ComponentManager components{entityManager, systemManager};
+        std::vector<Entity> entities;
+
+        explicit World(std::size_t count, bool withComponents = true) {
+            entities.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                Entity entity = entityManager.createEntity();
+                entities.push_back(entity);
+                if (withComponents) {
+                    components.addComponent<Position>(entity, {static_cast<float>(i), 0.f});
+                    components.addComponent<Velocity>(entity, {1.f, 0.f});
+                }
+            }
+        }
+    };
+}
+
+static void BM_ComponentAdd(bench::State &state) {
+    std::unique_ptr<World> world;
+    for (auto _: state) {
+        state.pauseTiming();
+        world = std::make_unique<World>(state.arg(), false);
+        state.resumeTiming();
+
+        for (Entity entity: world->entities) {
+            world->components.addComponent<Position>(entity, {1.f, 2.f});
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_ComponentAdd, 100, 1000, 10000, 100000);
+
+static void BM_ComponentGet(bench::State &state) {
+    World world(state.arg());
+    for (auto _: state) {
+        float sum = 0.f;
+        for (Entity entity: world.entities) {
+            sum += world.components.getComponent<Position>(entity).x;
+        }
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_ComponentGet, 100, 1000, 10000, 100000);
+
+static void BM_ComponentHas(bench::State &state) {
+    World world(state.arg());
+    for (auto _: state) {
+        std::size_t found = 0;
+        for (Entity entity: world.entities) {
+            found += world.components.hasComponent<Velocity>(entity);
+        }
+        bench::doNotOptimize(found);
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_ComponentHas, 100, 1000, 10000, 100000);
+
+static void BM_ComponentRemove(bench::State &state) {
+    std::unique_ptr<World> world;
+    for (auto _: state) {
+        state.pauseTiming();
+        world = std::make_unique<World>(state.arg());
+        state.resumeTiming();
+
+        for (Entity entity: world->entities) {
+            world->components.removeComponent<Velocity>(entity);
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_ComponentRemove, 100, 1000, 10000, 100000);
+
+static void BM_ComponentView(bench::State &state) {
+    World world(state.arg());
+    for (auto _: state) {
+        float sum = 0.f;
+        for (auto [entity, pos, vel]: world.components.view<Position, Velocity>()) {
+            sum += pos.x * vel.dx;
+        }
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_ComponentView, 100, 1000, 10000, 100000);
+
+// Every other one of state.arg() entities destroyed one at a time, as before the command buffer.
+static void BM_ComponentsDestroyEach(bench::State &state) {
+    std::unique_ptr<World> world;
+    for (auto _: state) {
+        state.pauseTiming();
+        world = std::make_unique<World>(state.arg());
+        state.resumeTiming();
+
+        for (std::size_t i = 0; i < world->entities.size(); i += 2) {
+            world->components.entityDestroyed(world->entities[i]);
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg() / 2);
+}
+BENCHMARK(BM_ComponentsDestroyEach, 1000, 100000);
+
+// The same entities destroyed as one batch, as the command buffer does.
+static void BM_ComponentsDestroyBatch(bench::State &state) {
+    std::unique_ptr<World> world;
+    std::vector<Entity> dead;
+    for (auto _: state) {
+        state.pauseTiming();
+        world = std::make_unique<World>(state.arg());
+        dead.clear();
+        for (std::size_t i = 0; i < world->entities.size(); i += 2) {
+            dead.push_back(world->entities[i]);
+        }
+        state.resumeTiming();
+
+        world->components.entitiesDestroyed(dead);
+    }
+    state.setItemsProcessed(state.iterations() * state.arg() / 2);
+}
+BENCHMARK(BM_ComponentsDestroyBatch, 1000, 100000);
@@ -0,0 +1,17 @@
+#include "Benchmark.h"
+#include "Engine/Engine.h"
+
+// Whole simulation steps of the real level and entities without a window, state.arg() steps per iteration.
+// Run from the directory holding assets/, like the game.
+static void BM_EngineStep(bench::State &state) {
+    Engine engine;
+    engine.setup(true);
+
+    for (auto _: state) {
+        for (std::int64_t i = 0; i < state.arg(); ++i) {
+            engine.step();
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_EngineStep, 1, 60);
@@ -0,0 +1,41 @@
+#include <memory>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/EntityManager.h"
+
+// Minting state.arg() IDs in a fresh manager.
+static void BM_EntityCreate(bench::State &state) {
+    std::unique_ptr<EntityManager> entityManager;
+    for (auto _: state) {
+        state.pauseTiming();
+        entityManager = std::make_unique<EntityManager>();
+        state.resumeTiming();
+
+        for (std::int64_t i = 0; i < state.arg(); ++i) {
+            bench::doNotOptimize(entityManager->createEntity());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_EntityCreate, 1000, 100000, 1000000);
+
+// Destroying state.arg() live entities and creating as many again from the recycled IDs.
+static void BM_EntityRecycle(bench::State &state) {
+    EntityManager entityManager;
+    std::vector<Entity> entities(state.arg());
+    for (Entity &entity: entities) {
+        entity = entityManager.createEntity();
+    }
+
+    for (auto _: state) {
+        for (Entity entity: entities) {
+            entityManager.destroyEntity(entity);
+        }
+        for (Entity &entity: entities) {
+            entity = entityManager.createEntity();
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_EntityRecycle, 1000, 100000, 1000000);
@@ -0,0 +1,109 @@
+#ifndef GENERATEDMAP_H
+#define GENERATEDMAP_H
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Engine/ComponentManager.h"
+#include "Engine/EntityManager.h"
+#include "Engine/SystemManager.h"
+#include "Engine/TilesetManager.h"
+#include "Engine/Core/CookedMap.h"
+#include "Engine/Systems/CollisionSystem.h"
+#include "Engine/Systems/TileMapSystem.h"
+#include "external/json/json.hpp"
+
+/**
+ * @brief Level layouts for benchmarks, written in the same JSON format as assets/maps/level.json.
+ *        A solid grass floor along the bottom row, short grass platforms every 8 rows and
+ *        a dirt/water backdrop in between, so the map has solid and visual-only tiles.
+ */
+namespace GeneratedMap {
+    constexpr int PLATFORM_SPACING = 8; // Rows between platforms
+    constexpr int PLATFORM_PERIOD = 16; // Columns between platform starts
+    constexpr int PLATFORM_LENGTH = 4;
+
+    inline bool isSolid(int x, int y, int height) {
+        if (y == height - 1) return true;
+        return y % PLATFORM_SPACING == PLATFORM_SPACING - 1 && x % PLATFORM_PERIOD < PLATFORM_LENGTH;
+    }
+
+    // Writes the map to the temp directory once and returns its path.
+    inline std::string path(int width, int height) {
+        std::filesystem::path file = std::filesystem::temp_directory_path() /
+                                     ("iskobr_bench_map_" + std::to_string(width) + "x" + std::to_string(height) + ".json");
+        if (std::filesystem::exists(file)) return file.string();
+
+        nlohmann::json rows = nlohmann::json::array();
+        for (int y = 0; y < height; ++y) {
+            nlohmann::json row = nlohmann::json::array();
+            for (int x = 0; x < width; ++x) {
+                if (isSolid(x, y, height)) {
+                    row.push_back({{"sheet", "grass"}, {"id", 1}});
+                } else if (y > height / 2) {
+                    row.push_back({{"sheet", (x / 8) % 2 ? "water" : "dirt"}, {"id", (x + y) % 4}});
+                } else {
+                    row.push_back(nullptr);
+                }
+            }
+            rows.push_back(std::move(row));
+        }
+
+        nlohmann::json map;
+        map["width"] = width;
+        map["height"] = height;
+        map["tiles"] = std::move(rows);
+        std::ofstream(file) << map;
+        return file.string();
+    }
+
+    // The same map cooked into the binary format (see CookedMap), written next to the JSON once.
+    inline std::string cookedPath(int width, int height) {
+        std::filesystem::path file = path(width, height);
+        std::filesystem::path json = file;
+        file.replace_extension(".map");
+        if (std::filesystem::exists(file)) return file.string();
+
+        std::ifstream in(json);
+        std::vector<unsigned char> cooked = CookedMap::cook(nlohmann::json::parse(in));
+        std::ofstream(file, std::ios::binary).write(reinterpret_cast<const char *>(cooked.data()),
+                                                    static_cast<std::streamsize>(cooked.size()));
+        return file.string();
+    }
+
+    /**
+     * @brief Registers the level's tilesets. With a texture the tiles get chunk geometry like in
+     *        the game, the texture is never uploaded so no window is needed.
+     */
+    inline void addTilesets(TilesetManager &tilesets, bool withTexture) {
+        static const std::shared_ptr<sf::Texture> texture = std::make_shared<sf::Texture>();
+        for (const char *name: {"grass", "water", "dirt", "*water"}) {
+            if (withTexture) {
+                tilesets.addTileset(name, TextureRegion{texture, {0, 0, 64, 64}}, 16, 16);
+            } else {
+                tilesets.addTileset(name, 16, 16);
+            }
+        }
+    }
+
+    // ECS with the collision and tile map systems, loaded with a generated map.
+    struct Level {
+        EntityManager entityManager;
+        SystemManager systemManager;
+        ComponentManager components{entityManager, systemManager};
+        TextureCache textureCache;
+        TilesetManager tilesets{textureCache};
+        std::shared_ptr<CollisionSystem> collision = systemManager.registerSystem<CollisionSystem>();
+        std::shared_ptr<TileMapSystem> tileMap = systemManager.registerSystem<TileMapSystem>();
+
+        Level(int width, int height) {
+            addTilesets(tilesets, false);
+            tileMap->loadMap(path(width, height), components, entityManager, tilesets, *collision);
+        }
+    };
+}
+
+#endif
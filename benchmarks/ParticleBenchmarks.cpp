@@ -0,0 +1,90 @@
+#include <memory>
+
+#include "Benchmark.h"
+#include "GeneratedMap.h"
+#include "Engine/Core/JobPool.h"
+#include "Engine/Core/UpdateContext.h"
+#include "Engine/Components/PlayerComponent.h"
+#include "Engine/Systems/ParticleSystem/FluidParticleSystem.h"
+#include "Engine/Systems/ParticleSystem/GaseousParticleSystem.h"
+#include "Engine/Systems/ParticleSystem/HomingParticleSystem.h"
+#include "Engine/Systems/ParticleSystem/StaticFluidParticleSystem.h"
+
+namespace {
+    constexpr int MAP_WIDTH = 64;
+    constexpr int MAP_HEIGHT = 48;
+
+    JobPool &jobPool() {
+        static JobPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Times one update of a particle system holding state.arg() particles over a generated level,
+     *        with a player entity to push them around. Particles that died are respawned untimed.
+     */
+    template<typename T>
+    void particleUpdate(bench::State &state, JobPool *jobs) {
+        GeneratedMap::Level level(MAP_WIDTH, MAP_HEIGHT);
+
+        Entity player = level.entityManager.createEntity();
+        ColliderComponent collider;
+        collider.bounds = {-15.f, -36.f, 34.f, 85.f};
+        level.components.addComponent<PlayerComponent>(player, {});
+        level.components.addComponent<ColliderComponent>(player, collider);
+        level.components.addComponent<Position>(player, {MAP_WIDTH * 24.f, MAP_HEIGHT * 40.f});
+        level.components.addComponent<Velocity>(player, {120.f, 0.f});
+
+        std::size_t count = state.arg();
+        T particles;
+        particles.setCollisionSystem(level.collision.get());
+        particles.setEmitter({MAP_WIDTH * 24.f, MAP_HEIGHT * 36.f});
+        particles.setMaxParticles(count);
+        particles.setSeed(1);
+
+        UpdateContext ctxt{};
+        ctxt.dt = 1.f / 60.f;
+        ctxt.tDt = sf::seconds(ctxt.dt);
+        ctxt.component = &level.components;
+        ctxt.entity = &level.entityManager;
+        ctxt.system = &level.systemManager;
+        ctxt.jobs = jobs;
+
+        for (auto _: state) {
+            state.pauseTiming();
+            particles.spawnParticles(count - particles.getParticleCount());
+            state.resumeTiming();
+
+            particles.update(ctxt);
+        }
+        state.setItemsProcessed(state.iterations() * count);
+    }
+}
+
+static void BM_FluidParticles(bench::State &state) { particleUpdate<FluidParticleSystem>(state, nullptr); }
+static void BM_FluidParticlesThreaded(bench::State &state) { particleUpdate<FluidParticleSystem>(state, &jobPool()); }
+BENCHMARK(BM_FluidParticles, 1000, 10000, 100000);
+BENCHMARK(BM_FluidParticlesThreaded, 1000, 10000, 100000);
+
+static void BM_StaticFluidParticles(bench::State &state) {
+    particleUpdate<StaticFluidParticleSystem>(state, nullptr);
+}
+static void BM_StaticFluidParticlesThreaded(bench::State &state) {
+    particleUpdate<StaticFluidParticleSystem>(state, &jobPool());
+}
+BENCHMARK(BM_StaticFluidParticles, 1000, 10000, 100000);
+BENCHMARK(BM_StaticFluidParticlesThreaded, 1000, 10000, 100000);
+
+static void BM_GaseousParticles(bench::State &state) { particleUpdate<GaseousParticleSystem>(state, nullptr); }
+static void BM_GaseousParticlesThreaded(bench::State &state) {
+    particleUpdate<GaseousParticleSystem>(state, &jobPool());
+}
+BENCHMARK(BM_GaseousParticles, 1000, 10000, 100000);
+BENCHMARK(BM_GaseousParticlesThreaded, 1000, 10000, 100000);
+
+static void BM_HomingParticles(bench::State &state) { particleUpdate<HomingParticleSystem>(state, nullptr); }
+static void BM_HomingParticlesThreaded(bench::State &state) {
+    particleUpdate<HomingParticleSystem>(state, &jobPool());
+}
+BENCHMARK(BM_HomingParticles, 1000, 10000, 100000);
+BENCHMARK(BM_HomingParticlesThreaded, 1000, 10000, 100000);
@@ -0,0 +1,79 @@
+#include <memory>
+
+#include "Benchmark.h"
+#include "Engine/PrefabManager.h"
+#include "Engine/Systems/AISystem.h"
+#include "Engine/Systems/CollisionSystem.h"
+#include "Engine/Systems/MovementSystem.h"
+#include "Engine/Systems/PhysicsSystem.h"
+
+namespace {
+    // Managers with the systems an enemy joins, and an enemy built like the entity file's.
+    struct SpawnWorld {
+        EntityManager entityManager;
+        SystemManager systemManager;
+        ComponentManager components{entityManager, systemManager};
+        PrefabManager prefabs{entityManager, components};
+        Prefab enemy{"Enemy"};
+
+        SpawnWorld() {
+            systemManager.registerSystem<MovementSystem>();
+            systemManager.registerSystem<PhysicsSystem>();
+            systemManager.registerSystem<CollisionSystem>();
+            systemManager.registerSystem<AISystem>();
+
+            ColliderComponent collider;
+            collider.bounds = {-15.f, -36.f, 34.f, 85.f};
+            enemy.set<ColliderComponent>(collider);
+            enemy.set<Velocity>({});
+            enemy.set<KnockBackComponent>({});
+            enemy.set<DirectionComponent>({});
+            enemy.set<HealthComponent>({});
+            enemy.set<ActorComponent>({"NPC1"});
+            enemy.set<SeekComponent>({});
+            enemy.set<AIComponent>({});
+        }
+    };
+}
+
+// Spawning state.arg() enemies with one addComponent() call per component, as loading used to.
+static void BM_SpawnByComponent(bench::State &state) {
+    std::unique_ptr<SpawnWorld> world;
+    for (auto _: state) {
+        state.pauseTiming();
+        world = std::make_unique<SpawnWorld>();
+        state.resumeTiming();
+
+        ComponentManager &components = world->components;
+        for (std::int64_t i = 0; i < state.arg(); ++i) {
+            Entity entity = world->entityManager.createEntity();
+            components.addComponent<ColliderComponent>(entity, *world->enemy.find<ColliderComponent>());
+            components.addComponent<Position>(entity, {100.f, 100.f});
+            components.addComponent<Velocity>(entity, {});
+            components.addComponent<KnockBackComponent>(entity, {});
+            components.addComponent<DirectionComponent>(entity, {});
+            components.addComponent<HealthComponent>(entity, {});
+            components.addComponent<ActorComponent>(entity, {"NPC1"});
+            components.addComponent<SeekComponent>(entity, {});
+            components.addComponent<AIComponent>(entity, {});
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_SpawnByComponent, 100, 10000);
+
+// Spawning state.arg() enemies from a prefab.
+static void BM_PrefabInstantiate(bench::State &state) {
+    std::unique_ptr<SpawnWorld> world;
+    for (auto _: state) {
+        state.pauseTiming();
+        world = std::make_unique<SpawnWorld>();
+        state.resumeTiming();
+
+        for (std::int64_t i = 0; i < state.arg(); ++i) {
+            bench::doNotOptimize(world->prefabs.instantiate(world->enemy, {100.f, 100.f}));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+BENCHMARK(BM_PrefabInstantiate, 100, 10000);
@@ -0,0 +1,48 @@
+#include <memory>
+#include <string>
+
+#include "Benchmark.h"
+#include "GeneratedMap.h"
+
+namespace {
+    // What Engine::setup() builds around a map load, minus the window.
+    struct MapLoader {
+        EntityManager entityManager;
+        SystemManager systemManager;
+        ComponentManager components{entityManager, systemManager};
+        TextureCache textureCache;
+        TilesetManager tilesets{textureCache};
+        std::shared_ptr<CollisionSystem> collision = systemManager.registerSystem<CollisionSystem>();
+        std::shared_ptr<TileMapSystem> tileMap = systemManager.registerSystem<TileMapSystem>();
+
+        MapLoader() { GeneratedMap::addTilesets(tilesets, true); }
+    };
+
+    // Loads the map from 'path' into a fresh MapLoader per iteration.
+    void loadMap(bench::State &state, const std::string &path) {
+        std::unique_ptr<MapLoader> loader;
+        for (auto _: state) {
+            state.pauseTiming();
+            loader = std::make_unique<MapLoader>();
+            state.resumeTiming();
+
+            loader->tileMap->loadMap(path, loader->components, loader->entityManager, loader->tilesets,
+                                     *loader->collision);
+        }
+        state.setItemsProcessed(state.iterations() * state.arg() * state.arg());
+    }
+}
+
+// Parsing a square map of state.arg() tiles per side, creating its tile entities and building its chunks.
+static void BM_TileMapLoad(bench::State &state) {
+    int size = static_cast<int>(state.arg());
+    loadMap(state, GeneratedMap::path(size, size));
+}
+BENCHMARK(BM_TileMapLoad, 64, 128, 256, 512);
+
+// The same map loaded from its cooked file instead of the JSON.
+static void BM_TileMapLoadCooked(bench::State &state) {
+    int size = static_cast<int>(state.arg());
+    loadMap(state, GeneratedMap::cookedPath(size, size));
+}
+BENCHMARK(BM_TileMapLoadCooked, 64, 128, 256, 512);
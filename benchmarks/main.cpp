@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Benchmark.h"
+#include "Engine/Core/Log.h"
+
+// Usage: iskobr_benchmarks [--filter <substring>] [--min-time <seconds>] [--csv]
+int main(int argc, char *argv[]) {
+    std::string filter;
+    double minTime = 0.5;
+    bool csv = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (option == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (option == "--csv") {
+            csv = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--min-time <seconds>] [--csv]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Setup code logs a lot, only errors are shown between the results.
+    Log::setLevel(Log::Level::Error);
+
+    if (csv) {
+        std::printf("name,iterations,ns_per_iteration,items_per_second\n");
+    } else {
+        std::printf("%-48s %12s %16s %16s\n", "Benchmark", "Iterations", "ns/iteration", "items/s");
+    }
+
+    for (const bench::Entry &entry: bench::registry()) {
+        for (std::int64_t arg: entry.args) {
+            std::string name = entry.name + "/" + std::to_string(arg);
+            if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+
+            // Grow the iteration count until one run lasts at least minTime.
+            std::size_t iterations = 1;
+            for (;;) {
+                bench::State state(arg, iterations);
+                entry.function(state);
+
+                if (state.skipped()) {
+                    if (csv) {
+                        std::printf("%s,0,,\n", name.c_str());
+                    } else {
+                        std::printf("%-48s skipped: %s\n", name.c_str(), state.getSkipReason().c_str());
+                    }
+                    break;
+                }
+
+                double seconds = state.seconds();
+                if (seconds >= minTime || iterations >= (std::size_t{1} << 30)) {
+                    double nsPerIteration = seconds * 1e9 / static_cast<double>(iterations);
+                    double itemsPerSecond = state.items() > 0 && seconds > 0.0 ? state.items() / seconds : 0.0;
+                    if (csv) {
+                        std::printf("%s,%zu,%.1f,%.0f\n", name.c_str(), iterations, nsPerIteration, itemsPerSecond);
+                    } else {
+                        std::printf("%-48s %12zu %16.1f %16.0f\n", name.c_str(), iterations, nsPerIteration,
+                                    itemsPerSecond);
+                    }
+                    break;
+                }
+
+                // Aim a little past minTime from the last measurement, at most 10x more per round.
+                double scale = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+                if (scale > 10.0) scale = 10.0;
+                if (scale < 2.0) scale = 2.0;
+                iterations = static_cast<std::size_t>(static_cast<double>(iterations) * scale);
+            }
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -1,59 +1,202 @@
 #ifndef COMPONENTMANAGER_H
 #define COMPONENTMANAGER_H
 
-#include <unordered_map>
+#include <algorithm>
+#include <array>
 #include <memory>
-#include <typeindex>
-#include <typeinfo>
+#include <tuple>
 #include <cstdint>
 #include <cassert>
+#include <limits>
+#include <vector>
+
+#include "Engine/EntityManager.h"
+#include "Engine/SystemManager.h"
+#include "Engine/Core/ComponentType.h"
+#include "Engine/Core/EntitySet.h"
 
 /**
  * This system allows for the destruction of any number of component types in a safe manner.
  */
 
-
-//Entity ID type alias/
-using Entity = std::uint32_t;
-
 class IComponentArray {
 public:
     virtual ~IComponentArray() = default;
 
     virtual void entityDestroyed(Entity entity) = 0;
+
+    virtual void entitiesDestroyed(const std::vector<Entity> &entities) {
+        for (Entity entity: entities) {
+            entityDestroyed(entity);
+        }
+    }
 };
 
 /**
  * @brief Template class that stores components of the specific type T.
- *        Where each component is mapped to an entity.
+ *        Components are packed contiguously in a dense array, with a sparse
+ *        index (one slot per entity ID, grown on demand) mapping each entity to its
+ *        component. Removal swaps the last component into the freed slot.
+ *        NOTE: references returned by get() are invalidated by insert/remove on the same array.
  * @tparam T
  */
 template<typename T>
 class ComponentArray : public IComponentArray {
 public:
     void insert(Entity entity, T component) {
-        components[entity] = component;
+        if (has(entity)) {
+            dense[sparse[entity]] = std::move(component);
+            return;
+        }
+        if (entity >= sparse.size()) {
+            sparse.resize(std::max<std::size_t>(entity + 1, sparse.size() * 2), npos);
+        }
+        sparse[entity] = static_cast<std::uint32_t>(dense.size());
+        dense.push_back(std::move(component));
+        packed.push_back(entity);
     }
 
     void remove(Entity entity) {
-        components.erase(entity);
+        if (!has(entity)) return;
+
+        // Swap-and-pop: move the last component into the removed slot.
+        std::size_t index = sparse[entity];
+        std::size_t last = dense.size() - 1;
+        if (index != last) {
+            dense[index] = std::move(dense[last]);
+            packed[index] = packed[last];
+            sparse[packed[index]] = static_cast<std::uint32_t>(index);
+        }
+        dense.pop_back();
+        packed.pop_back();
+        sparse[entity] = npos;
     }
 
     T &get(Entity entity) {
-        assert(components.find(entity) != components.end() && "Component not found.");
-        return components[entity];
+        assert(has(entity) && "Component not found.");
+        return dense[sparse[entity]];
     }
 
     bool has(Entity entity) const {
-        return components.find(entity) != components.end();
+        return entity < sparse.size() && sparse[entity] != npos;
+    }
+
+    // Single lookup variant of has() + get(), nullptr when the entity has no component.
+    T *tryGet(Entity entity) {
+        return has(entity) ? &dense[sparse[entity]] : nullptr;
+    }
+
+    std::size_t size() const {
+        return dense.size();
+    }
+
+    // Entities that own a component in this array, in storage order.
+    const std::vector<Entity> &entities() const {
+        return packed;
     }
 
     void entityDestroyed(Entity entity) override {
-        components.erase(entity);
+        remove(entity);
+    }
+
+    // Unlinks every destroyed entity, then closes the gaps in one pass from the first freed slot.
+    // Unlike remove(), the remaining components keep their order.
+    void entitiesDestroyed(const std::vector<Entity> &entities) override {
+        std::size_t first = dense.size();
+        for (Entity entity: entities) {
+            if (!has(entity)) continue;
+            first = std::min<std::size_t>(first, sparse[entity]);
+            sparse[entity] = npos;
+        }
+
+        std::size_t kept = first;
+        for (std::size_t index = first; index < dense.size(); ++index) {
+            if (sparse[packed[index]] == npos) continue;
+            if (index != kept) {
+                dense[kept] = std::move(dense[index]);
+                packed[kept] = packed[index];
+            }
+            sparse[packed[kept]] = static_cast<std::uint32_t>(kept);
+            ++kept;
+        }
+        dense.erase(dense.begin() + kept, dense.end());
+        packed.erase(packed.begin() + kept, packed.end());
+    }
+
+private:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<T> dense; // Packed components
+    std::vector<Entity> packed; // Entity owning each dense slot
+    std::vector<std::uint32_t> sparse; // Entity ID -> dense index (npos if absent)
+};
+
+/**
+ * @brief Iterable view over every entity in a list that owns all of the given components.
+ *        Dereferencing yields a tuple of the entity and references to its components:
+ *        for (auto [entity, pos, vel] : components.view<Position, Velocity>()) {...}
+ *        Each entity costs one sparse lookup per component type, entities missing
+ *        any of them are skipped. Entities appended to the list while iterating are visited.
+ * @tparam Components
+ */
+template<typename... Components>
+class ComponentView {
+public:
+    using Arrays = std::tuple<ComponentArray<Components> *...>;
+    using Row = std::tuple<Entity, Components &...>;
+
+    struct Sentinel {
+    };
+
+    class Iterator {
+    public:
+        Iterator(const std::vector<Entity> *list, Arrays arrays) : list(list), arrays(arrays) {
+            settle();
+        }
+
+        Row operator*() const {
+            return std::apply([this](auto *... component) { return Row((*list)[index], *component...); }, row);
+        }
+
+        Iterator &operator++() {
+            ++index;
+            settle();
+            return *this;
+        }
+
+        bool operator!=(Sentinel) const {
+            return index < list->size();
+        }
+
+    private:
+        const std::vector<Entity> *list;
+        std::size_t index = 0;
+        Arrays arrays;
+        std::tuple<Components *...> row;
+
+        // Advances to the next entity that owns every component, caching the component pointers.
+        void settle() {
+            for (; index < list->size(); ++index) {
+                Entity entity = (*list)[index];
+                row = std::apply([entity](auto *... array) {
+                    return std::tuple<Components *...>(array->tryGet(entity)...);
+                }, arrays);
+                if (std::apply([](auto *... component) { return ((component != nullptr) && ...); }, row)) {
+                    return;
+                }
+            }
+        }
+    };
+
+    ComponentView(const std::vector<Entity> &list, Arrays arrays) : list(&list), arrays(arrays) {
     }
 
+    Iterator begin() const { return Iterator(list, arrays); }
+    Sentinel end() const { return {}; }
+
 private:
-    std::unordered_map<Entity, T> components;
+    const std::vector<Entity> *list;
+    Arrays arrays;
 };
 
 /**
@@ -62,49 +205,127 @@ private:
  */
 class ComponentManager {
 public:
+    ComponentManager() = default;
+
+    // Binds the managers that track entity signatures and system membership.
+    ComponentManager(EntityManager &entityManager, SystemManager &systemManager)
+        : entityManager(&entityManager), systemManager(&systemManager) {
+    }
+
+    // Creates the pools for the given types up front. Pools are otherwise created on first use,
+    // which must not happen while the SystemScheduler runs systems in parallel.
+    template<typename... Components>
+    void registerComponents() {
+        (getComponentArray<Components>(), ...);
+    }
+
     template<typename T>
     void addComponent(Entity entity, T component) {
-        getComponentArray<T>()->insert(entity, component);
+        getComponentArray<T>().insert(entity, std::move(component));
+        updateSignature(entity, componentType<T>(), true);
+    }
+
+    // addComponent() without the signature update, for callers that set the whole signature afterwards.
+    template<typename T>
+    void insertComponent(Entity entity, T component) {
+        getComponentArray<T>().insert(entity, std::move(component));
+    }
+
+    // Replaces the entity's signature and updates its system membership in one pass over the systems.
+    void setSignature(Entity entity, Signature signature) {
+        if (!entityManager) return;
+
+        entityManager->setSignature(entity, signature);
+        if (systemManager) {
+            systemManager->entitySignatureChanged(entity, signature);
+        }
     }
 
     template<typename T>
     void removeComponent(Entity entity) {
-        getComponentArray<T>()->remove(entity);
+        getComponentArray<T>().remove(entity);
+        updateSignature(entity, componentType<T>(), false);
     }
 
     template<typename T>
     T &getComponent(Entity entity) {
-        return getComponentArray<T>()->get(entity);
+        return getComponentArray<T>().get(entity);
     }
 
     template<typename T>
     bool hasComponent(Entity entity) {
-        return getComponentArray<T>()->has(entity);
+        return getComponentArray<T>().has(entity);
+    }
+
+    // Every entity owning all of the given components, walking the smallest of their arrays.
+    template<typename... Components>
+    ComponentView<Components...> view() {
+        auto arrays = std::make_tuple(&getComponentArray<Components>()...);
+        const std::vector<Entity> *smallest = nullptr;
+        std::apply([&smallest](auto *... array) {
+            ((smallest = (!smallest || array->size() < smallest->size()) ? &array->entities() : smallest), ...);
+        }, arrays);
+        return ComponentView<Components...>(*smallest, arrays);
+    }
+
+    // Same as view() but walks a system's entity list, keeping its order and filters.
+    template<typename... Components>
+    ComponentView<Components...> view(const EntitySet &entities) {
+        return ComponentView<Components...>(entities.list(), std::make_tuple(&getComponentArray<Components>()...));
+    }
+
+    // Keeps 'target' on an entity owning all of the given components, searching for the first one again only
+    // when the entity it refers to was destroyed or lost one of them. False when no entity matches.
+    template<typename... Components>
+    bool track(EntityHandle &target, const EntityManager &entities) {
+        if (entities.isAlive(target) && (hasComponent<Components>(target.index) && ...)) return true;
+
+        target = InvalidHandle;
+        for (auto row: view<Components...>()) {
+            target = entities.getHandle(std::get<0>(row));
+            return true;
+        }
+        return false;
     }
 
     void entityDestroyed(Entity entity) {
-        for (auto const &pair: componentArrays) {
-            pair.second->entityDestroyed(entity);
+        for (auto const &array: componentArrays) {
+            if (array) array->entityDestroyed(entity);
+        }
+    }
+
+    // Batched entityDestroyed(), one pass over each pool for the whole list.
+    void entitiesDestroyed(const std::vector<Entity> &entities) {
+        for (auto const &array: componentArrays) {
+            if (array) array->entitiesDestroyed(entities);
         }
     }
 
 private:
-    // Maps type_index (component type) -> ComponentArray base ptr.
-    std::unordered_map<std::type_index, std::shared_ptr<IComponentArray> > componentArrays;
+    EntityManager *entityManager = nullptr;
+    SystemManager *systemManager = nullptr;
+
+    // Indexed by component type ID -> ComponentArray base ptr.
+    std::array<std::unique_ptr<IComponentArray>, MAX_COMPONENTS> componentArrays;
 
     // Internal helper for retrieving a typed component array.
     template<typename T>
-    std::shared_ptr<ComponentArray<T> > getComponentArray() {
-        std::type_index typeIndex = typeid(T);
-
-        auto it = componentArrays.find(typeIndex);
-        if (it == componentArrays.end()) {
+    ComponentArray<T> &getComponentArray() {
+        auto &array = componentArrays[componentType<T>()];
+        if (!array) {
             // if not found, create and store a new component array for this type.
-            auto newArray = std::make_shared<ComponentArray<T> >();
-            componentArrays[typeIndex] = newArray;
-            return newArray;
+            array = std::make_unique<ComponentArray<T> >();
         }
-        return std::static_pointer_cast<ComponentArray<T> >(it->second);
+        return static_cast<ComponentArray<T> &>(*array);
+    }
+
+    // Flips one bit of the entity's signature and lets the systems re-evaluate membership.
+    void updateSignature(Entity entity, ComponentType type, bool present) {
+        if (!entityManager) return;
+
+        Signature signature = entityManager->getSignature(entity);
+        signature.set(type, present);
+        setSignature(entity, signature);
     }
 };
 
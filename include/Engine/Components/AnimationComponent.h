@@ -8,7 +8,8 @@
  * Use a sprite sheet and cycle through frames horizontallz.
  */
 struct AnimationData {
-    std::shared_ptr<sf::Texture> texture;
+    std::shared_ptr<sf::Texture> texture; // Shared through the TextureCache, usually an atlas
+    sf::IntRect region; // Area of texture holding this sheet's frames
     int frameCount;
     int currentFrame;
     int frameWidth;
@@ -14,6 +14,10 @@ struct ColliderComponent {
     std::string tag = ""; // For debug logic
 
     bool active = true; // For animation control.
+
+    bool sleeping = false; // Set by the collision system for dynamic bodies at rest.
+    sf::Vector2f restPosition; // Where the body came to rest, moving it wakes it up.
+    int restSteps = 0; // Steps in a row spent resting on a support
 };
 
 #endif
@@ -1,10 +1,10 @@
 #ifndef SEEKCOMPONENT_H
 #define SEEKCOMPONENT_H
 
-#include <cstdint>
+#include "Engine/EntityManager.h"
 
 struct SeekComponent {
-    std::uint32_t targetEntityId;
+    EntityHandle target; // Stays safe to check after the target is destroyed
     float speed = 100.f;
 };
 
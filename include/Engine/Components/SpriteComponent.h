@@ -11,6 +11,7 @@
 struct SpriteComponent {
     sf::Sprite sprite;
     bool flipX = false;
+    int zOrder = 0; // Lower is drawn first, ties keep their submission order
 };
 
 #endif
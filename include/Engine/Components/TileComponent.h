@@ -5,7 +5,6 @@
 #include "Engine/Core/TileType.h"
 
 struct TileComponent {
-    sf::Sprite sprite;
     TileType type = TileType::Empty;
     bool isSolid = false;
     bool isAnimated = false;
@@ -0,0 +1,92 @@
+#ifndef ATLASPACKER_H
+#define ATLASPACKER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+/**
+ * @brief Shelf packer that places rectangles onto square atlas pages.
+ *        Rectangles are laid out left to right on shelves, a new shelf is opened below the last
+ *        one when a row is full and a new page is opened when a page is full.
+ *        Inserting rectangles tallest first gives the tightest result.
+ */
+class AtlasPacker {
+public:
+    explicit AtlasPacker(unsigned pageSize, unsigned padding = 1)
+        : pageSize(pageSize), padding(padding) {
+    }
+
+    /**
+     * @brief Finds room for a rectangle of the given size.
+     * @return False if the rectangle is larger than a page.
+     */
+    bool insert(sf::Vector2u size, std::size_t &page, sf::Vector2u &position) {
+        if (size.x > pageSize || size.y > pageSize) return false;
+
+        for (std::size_t p = 0; p < pages.size(); ++p) {
+            if (place(pages[p], size, position)) {
+                page = p;
+                return true;
+            }
+        }
+
+        pages.emplace_back();
+        page = pages.size() - 1;
+        return place(pages.back(), size, position);
+    }
+
+    std::size_t getPageCount() const { return pages.size(); }
+
+    // Area of the page that is actually used, so atlases can be trimmed to it.
+    sf::Vector2u getUsedSize(std::size_t page) const { return pages[page].used; }
+
+private:
+    struct Shelf {
+        unsigned y = 0;
+        unsigned height = 0;
+        unsigned cursorX = 0;
+    };
+
+    struct Page {
+        std::vector<Shelf> shelves;
+        unsigned nextShelfY = 0;
+        sf::Vector2u used{0, 0};
+    };
+
+    unsigned pageSize;
+    unsigned padding; // Gap kept between neighbours so filtering never samples the next image
+    std::vector<Page> pages;
+
+    bool place(Page &page, sf::Vector2u size, sf::Vector2u &position) {
+        for (Shelf &shelf: page.shelves) {
+            if (size.y <= shelf.height && shelf.cursorX + size.x <= pageSize) {
+                position = {shelf.cursorX, shelf.y};
+                shelf.cursorX += size.x + padding;
+                grow(page, position, size);
+                return true;
+            }
+        }
+
+        if (page.nextShelfY + size.y > pageSize) return false;
+
+        Shelf shelf;
+        shelf.y = page.nextShelfY;
+        shelf.height = size.y;
+        shelf.cursorX = size.x + padding;
+        page.shelves.push_back(shelf);
+        page.nextShelfY += size.y + padding;
+
+        position = {0, shelf.y};
+        grow(page, position, size);
+        return true;
+    }
+
+    static void grow(Page &page, sf::Vector2u position, sf::Vector2u size) {
+        page.used.x = std::max(page.used.x, position.x + size.x);
+        page.used.y = std::max(page.used.y, position.y + size.y);
+    }
+};
+
+#endif
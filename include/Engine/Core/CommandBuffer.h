@@ -0,0 +1,112 @@
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Engine/ComponentManager.h"
+#include "Engine/EntityManager.h"
+#include "Engine/SystemManager.h"
+#include "Engine/Core/Prefab.h"
+
+/**
+ * @brief Structural changes recorded during a frame and applied together at a sync point.
+ *        Systems must not create or destroy entities or add/remove components while the scheduler
+ *        runs them, they record the change here instead and flush() applies everything once the
+ *        systems are done. Recording is safe from systems running in parallel.
+ *        flush() first runs the spawns and component changes in the order they were recorded, then
+ *        destroys every entity marked with destroy(): its components are removed from every pool, it
+ *        leaves every system and its ID is recycled. Until then it stays fully valid.
+ */
+class CommandBuffer {
+public:
+    using SpawnFunction = std::function<void(Entity, ComponentManager &)>;
+
+    void destroy(Entity entity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        destroyed.push_back(entity);
+    }
+
+    template<typename T>
+    void addComponent(Entity entity, T component) {
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.push_back([entity, component = std::move(component)](EntityManager &, ComponentManager &components) mutable {
+            components.addComponent<T>(entity, std::move(component));
+        });
+    }
+
+    template<typename T>
+    void removeComponent(Entity entity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.push_back([entity](EntityManager &, ComponentManager &components) {
+            components.removeComponent<T>(entity);
+        });
+    }
+
+    // Creates an entity at the flush and hands it to 'build' to add its components.
+    void spawn(SpawnFunction build) {
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.push_back([build = std::move(build)](EntityManager &entities, ComponentManager &components) {
+            build(entities.createEntity(), components);
+        });
+    }
+
+    // Creates an entity from the prefab at the flush, placed at 'position'. The prefab must outlive the flush.
+    void instantiate(const Prefab &prefab, Position position) {
+        spawn([&prefab, position](Entity entity, ComponentManager &components) {
+            prefab.cloneTo(entity, components, position);
+        });
+    }
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return commands.empty() && destroyed.empty();
+    }
+
+    // Applies and clears everything recorded, from the main thread while no system is running.
+    void flush(EntityManager &entities, ComponentManager &components, SystemManager &systems) {
+        // Commands may record more commands (a spawned entity's setup, ...), those run in the same flush.
+        std::vector<Command> pending;
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (commands.empty()) break;
+                pending.swap(commands);
+            }
+            for (Command &command: pending) {
+                command(entities, components);
+            }
+            pending.clear();
+        }
+
+        std::vector<Entity> dead;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dead.swap(destroyed);
+        }
+        if (dead.empty()) return;
+
+        // The same entity may have been marked by several systems, or already be gone.
+        std::sort(dead.begin(), dead.end());
+        dead.erase(std::unique(dead.begin(), dead.end()), dead.end());
+        std::erase_if(dead, [&entities](Entity entity) { return !entities.isAlive(entity); });
+
+        components.entitiesDestroyed(dead);
+        systems.entitiesDestroyed(dead);
+        for (Entity entity: dead) {
+            entities.destroyEntity(entity);
+        }
+    }
+
+private:
+    using Command = std::function<void(EntityManager &, ComponentManager &)>;
+
+    mutable std::mutex mutex;
+    std::vector<Command> commands;
+    std::vector<Entity> destroyed;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef COMPONENTTYPE_H
+#define COMPONENTTYPE_H
+
+#include <atomic>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+
+// Component type ID, used to index the component pools.
+using ComponentType = std::uint8_t;
+
+// Maximum number of distinct component types
+constexpr ComponentType MAX_COMPONENTS = 64;
+
+// Bitmask of component types, one bit per ComponentType.
+using Signature = std::bitset<MAX_COMPONENTS>;
+
+/**
+ * @brief Hands out sequential component type IDs, one per component struct,
+ *        assigned the first time each type is used.
+ */
+inline ComponentType nextComponentType() {
+    static std::atomic<ComponentType> counter{0};
+    ComponentType type = counter.fetch_add(1);
+    assert(type < MAX_COMPONENTS && "Too many component types.");
+    return type;
+}
+
+template<typename T>
+ComponentType componentType() {
+    static const ComponentType type = nextComponentType();
+    return type;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef COOKEDMAP_H
+#define COOKEDMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "external/json/json.hpp"
+
+/**
+ * @brief Binary tile map format, cooked from the editor's JSON by the map_cooker tool and read in place.
+ *        Layout, little-endian:
+ *          Header
+ *          Tileset table: tilesetCount names, TILESET_NAME_SIZE bytes each, NUL padded
+ *          Layers: layerCount planes of width * height uint16 cells, row by row
+ *          Solidity: one bit per cell, row by row, cell i is bit i % 8 of byte i / 8
+ *        A cell is (tileset index << TILE_ID_BITS) | tile ID, or EMPTY_CELL.
+ */
+namespace CookedMap {
+    constexpr char MAGIC[4] = {'I', 'S', 'K', 'M'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::size_t TILESET_NAME_SIZE = 32;
+    constexpr int TILE_ID_BITS = 12;
+    constexpr std::uint16_t MAX_TILE_ID = (1u << TILE_ID_BITS) - 1;
+    constexpr std::size_t MAX_TILESETS = (0xFFFFu >> TILE_ID_BITS); // The last index is left to EMPTY_CELL
+    constexpr std::uint16_t EMPTY_CELL = 0xFFFF;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t layerCount;
+        std::uint32_t tilesetCount;
+        std::uint32_t layersOffset; // Byte offsets from the start of the file
+        std::uint32_t solidityOffset;
+    };
+
+    inline bool isCooked(const unsigned char *data, std::size_t size) {
+        return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    /**
+     * @brief Read-only access to a cooked map held in memory, usually a MappedFile.
+     *        Nothing is copied, the bytes must outlive the view. Throws std::runtime_error
+     *        if they are not a valid cooked map.
+     */
+    class View {
+    public:
+        View(const unsigned char *data, std::size_t size) : data(data) {
+            if (!isCooked(data, size) || size < sizeof(Header)) {
+                throw std::runtime_error("Not a cooked map");
+            }
+            std::memcpy(&header, data, sizeof(Header));
+            if (header.version != VERSION) {
+                throw std::runtime_error("Cooked map version " + std::to_string(header.version) +
+                                         ", expected " + std::to_string(VERSION) + ", cook it again");
+            }
+
+            std::uint64_t cells = std::uint64_t{header.width} * header.height;
+            std::uint64_t tableEnd = sizeof(Header) + std::uint64_t{header.tilesetCount} * TILESET_NAME_SIZE;
+            std::uint64_t layersEnd = header.layersOffset + cells * header.layerCount * sizeof(std::uint16_t);
+            std::uint64_t solidityEnd = header.solidityOffset + (cells + 7) / 8;
+            if (tableEnd > header.layersOffset || layersEnd > header.solidityOffset || solidityEnd > size ||
+                header.layersOffset % alignof(std::uint16_t) != 0) {
+                throw std::runtime_error("Cooked map is truncated or corrupt");
+            }
+        }
+
+        int getWidth() const { return static_cast<int>(header.width); }
+        int getHeight() const { return static_cast<int>(header.height); }
+        std::size_t getLayerCount() const { return header.layerCount; }
+        std::size_t getTilesetCount() const { return header.tilesetCount; }
+
+        std::string_view getTilesetName(std::size_t index) const {
+            std::string_view name(reinterpret_cast<const char *>(data + sizeof(Header) + index * TILESET_NAME_SIZE),
+                                  TILESET_NAME_SIZE);
+            return name.substr(0, name.find('\0'));
+        }
+
+        std::uint16_t getCell(std::size_t layer, int x, int y) const {
+            std::size_t index = (layer * header.height + y) * header.width + x;
+            std::uint16_t cell;
+            std::memcpy(&cell, data + header.layersOffset + index * sizeof(cell), sizeof(cell));
+            return cell;
+        }
+
+        bool isSolid(int x, int y) const {
+            std::size_t index = static_cast<std::size_t>(y) * header.width + x;
+            return (data[header.solidityOffset + index / 8] >> (index % 8)) & 1u;
+        }
+
+    private:
+        const unsigned char *data;
+        Header header{};
+    };
+
+    /**
+     * @brief Cooks a map in the editor's JSON format: {"width", "height", "tiles": rows of
+     *        null or {"sheet", "id"}}. Throws std::runtime_error if it does not fit the format.
+     */
+    inline std::vector<unsigned char> cook(const nlohmann::json &map) {
+        std::uint32_t width = map.at("width").get<std::uint32_t>();
+        std::uint32_t height = map.at("height").get<std::uint32_t>();
+        const auto &rows = map.at("tiles");
+        std::size_t cells = std::size_t{width} * height;
+
+        std::vector<std::string> tilesets;
+        std::vector<std::uint16_t> layer(cells, EMPTY_CELL);
+        std::vector<unsigned char> solidity((cells + 7) / 8, 0);
+
+        for (std::uint32_t y = 0; y < height; ++y) {
+            const auto &row = rows.at(y);
+            for (std::uint32_t x = 0; x < width; ++x) {
+                const auto &cell = row.at(x);
+                if (cell.is_null()) continue;
+
+                const std::string &sheet = cell.at("sheet").get_ref<const std::string &>();
+                int tileID = cell.at("id").get<int>();
+                if (tileID < 0 || tileID > MAX_TILE_ID) {
+                    throw std::runtime_error("Tile ID " + std::to_string(tileID) + " out of range");
+                }
+
+                std::size_t tileset = 0;
+                while (tileset < tilesets.size() && tilesets[tileset] != sheet) ++tileset;
+                if (tileset == tilesets.size()) {
+                    if (tilesets.size() == MAX_TILESETS) throw std::runtime_error("Too many tilesets");
+                    if (sheet.size() >= TILESET_NAME_SIZE) throw std::runtime_error("Tileset name too long: " + sheet);
+                    tilesets.push_back(sheet);
+                }
+
+                std::size_t index = std::size_t{y} * width + x;
+                layer[index] = static_cast<std::uint16_t>(tileset << TILE_ID_BITS | tileID);
+
+                // Only grass collides for now, might come from the tileset data later
+                if (sheet == "grass") {
+                    solidity[index / 8] |= static_cast<unsigned char>(1u << (index % 8));
+                }
+            }
+        }
+
+        std::uint64_t layersOffset = sizeof(Header) + tilesets.size() * TILESET_NAME_SIZE;
+        std::uint64_t solidityOffset = layersOffset + std::uint64_t{cells} * sizeof(std::uint16_t);
+        if (solidityOffset + solidity.size() > UINT32_MAX) throw std::runtime_error("Map too large");
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.width = width;
+        header.height = height;
+        header.layerCount = 1;
+        header.tilesetCount = static_cast<std::uint32_t>(tilesets.size());
+        header.layersOffset = static_cast<std::uint32_t>(layersOffset);
+        header.solidityOffset = static_cast<std::uint32_t>(solidityOffset);
+
+        std::vector<unsigned char> bytes(header.solidityOffset + solidity.size(), 0);
+        std::memcpy(bytes.data(), &header, sizeof(Header));
+        for (std::size_t i = 0; i < tilesets.size(); ++i) {
+            std::memcpy(bytes.data() + sizeof(Header) + i * TILESET_NAME_SIZE, tilesets[i].data(), tilesets[i].size());
+        }
+        std::memcpy(bytes.data() + header.layersOffset, layer.data(), cells * sizeof(std::uint16_t));
+        std::memcpy(bytes.data() + header.solidityOffset, solidity.data(), solidity.size());
+        return bytes;
+    }
+}
+
+#endif
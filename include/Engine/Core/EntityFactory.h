@@ -5,48 +5,40 @@
 #ifndef ISKOBRENGINE_ENTITYFACTORY_H
 #define ISKOBRENGINE_ENTITYFACTORY_H
 
-#include "Engine/ComponentManager.h"
-#include "Engine/EntityManager.h"
-#include "Engine/SystemManager.h"
+#include <cmath>
+
+#include "Engine/PrefabManager.h"
+#include "Engine/Core/CommandBuffer.h"
 #include "Engine/Core/UpdateContext.h"
-#include "Engine/Components/Position.h"
+#include "Engine/Core/Log.h"
 #include "Engine/Components/Velocity.h"
-#include "Engine/Components/ProjectileComponent.h"
-#include "Engine/Components/EmitterComponent.h"
-#include "Engine/Systems/EmitterSystem.h"
-#include "Engine/Systems/ProjectileSystem.h"
 
 namespace EntityFactory
 {
+    // The projectile is created from the "Projectile" prefab when the frame's commands are flushed, after the systems ran.
+    // It flies along (dirX, dirY) at the speed of the prefab's Velocity.
+    // ProjectileSystem and EmitterSystem pick it up from its signature.
     inline void spawnParticleProjectile(const UpdateContext& ctxt, float startX, float startY, float dirX, float dirY)
     {
-        ComponentManager &components = *ctxt.component;
-        EntityManager &entityManager = *ctxt.entity;
-        SystemManager &systemManager = *ctxt.system;
-
-        Entity projectile = entityManager.createEntity();
-
-        components.addComponent<Position>(projectile, {startX, startY});
-        float speed = 500.0f;
-        components.addComponent<Velocity>(projectile, {speed, 0.0f});
-        components.addComponent<ProjectileComponent>(projectile, {
-            3.0f,
-            "gas",
-            false
-        });
-
-        components.addComponent<EmitterComponent>(projectile, {
-            "gas",
-            5
+        const Prefab *projectile = ctxt.prefabs->get("Projectile");
+        if (!projectile)
+        {
+            LOG_ERROR("No Projectile prefab loaded");
+            return;
+        }
+        ctxt.commands->spawn([projectile, startX, startY, dirX, dirY](Entity entity, ComponentManager& components)
+        {
+            projectile->cloneTo(entity, components, {startX, startY});
+
+            float length = std::hypot(dirX, dirY);
+            if (length > 0.f && components.hasComponent<Velocity>(entity))
+            {
+                auto& velocity = components.getComponent<Velocity>(entity);
+                float speed = std::hypot(velocity.dx, velocity.dy);
+                velocity = {dirX / length * speed, dirY / length * speed};
+            }
+            LOG_DEBUG("Projectile created {" << entity << "}");
         });
-
-        auto projSys = systemManager.getSystem<ProjectileSystem>();
-        if (projSys) projSys->entities.insert(projectile);
-
-        auto emitSys = systemManager.getSystem<EmitterSystem>();
-        if (emitSys) emitSys->entities.insert(projectile);
-
-        std::cout << "PROJECTILE ENTITY CREATED {" << projectile << "}" << std::endl;
     }
 }
 
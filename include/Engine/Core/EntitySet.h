@@ -0,0 +1,78 @@
+#ifndef ENTITYSET_H
+#define ENTITYSET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using Entity = std::uint32_t;
+
+/**
+ * @brief Set of entity IDs stored as a packed, contiguous list so systems can
+ *        iterate it linearly. A sparse index (entity ID -> position in the list)
+ *        gives O(1) insert, erase and lookup; erase swaps the last entity into
+ *        the freed slot, so iteration order is not preserved unless sort() is called.
+ */
+class EntitySet {
+public:
+    using const_iterator = std::vector<Entity>::const_iterator;
+
+    bool insert(Entity entity) {
+        if (contains(entity)) return false;
+
+        if (entity >= index.size()) {
+            index.resize(entity + 1, npos);
+        }
+        index[entity] = static_cast<std::uint32_t>(packed.size());
+        packed.push_back(entity);
+        return true;
+    }
+
+    bool erase(Entity entity) {
+        if (!contains(entity)) return false;
+
+        std::uint32_t slot = index[entity];
+        Entity last = packed.back();
+        packed[slot] = last;
+        index[last] = slot;
+        packed.pop_back();
+        index[entity] = npos;
+        return true;
+    }
+
+    bool contains(Entity entity) const {
+        return entity < index.size() && index[entity] != npos;
+    }
+
+    // Orders the entities by ID, which walks the component arrays in a friendlier order.
+    void sort() {
+        std::sort(packed.begin(), packed.end());
+        for (std::uint32_t i = 0; i < packed.size(); ++i) {
+            index[packed[i]] = i;
+        }
+    }
+
+    void clear() {
+        for (Entity entity: packed) {
+            index[entity] = npos;
+        }
+        packed.clear();
+    }
+
+    std::size_t size() const { return packed.size(); }
+    bool empty() const { return packed.empty(); }
+
+    const_iterator begin() const { return packed.begin(); }
+    const_iterator end() const { return packed.end(); }
+
+    const std::vector<Entity> &list() const { return packed; }
+
+private:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<Entity> packed; // Member entities, contiguous
+    std::vector<std::uint32_t> index; // Entity ID -> slot in 'packed' (npos if absent)
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+/**
+ * @brief Turns variable frame times into a whole number of fixed simulation steps.
+ *        Frame time is accumulated and consumed one step at a time. At most maxSteps are run
+ *        per frame, time beyond that is dropped so a long hitch can't snowball into slower frames.
+ *        getAlpha() is how far the leftover time reaches into the next step, for interpolating
+ *        the rendered state between the last two steps.
+ */
+class FixedTimestep {
+public:
+    static constexpr float DEFAULT_RATE = 60.f; // Steps per second
+    static constexpr int DEFAULT_MAX_STEPS = 5;
+
+    explicit FixedTimestep(float rate = DEFAULT_RATE, int maxSteps = DEFAULT_MAX_STEPS) {
+        setRate(rate);
+        setMaxSteps(maxSteps);
+    }
+
+    void setRate(float rate) {
+        assert(rate > 0.f && "Timestep rate must be positive.");
+        stepSeconds = 1.0 / rate;
+    }
+
+    void setMaxSteps(int steps) { maxSteps = std::max(steps, 1); }
+
+    float getStep() const { return static_cast<float>(stepSeconds); }
+    int getMaxSteps() const { return maxSteps; }
+
+    // Adds one frame's elapsed time and returns how many steps to simulate for it.
+    int advance(float frameSeconds) {
+        accumulator += frameSeconds;
+
+        int steps = 0;
+        while (accumulator >= stepSeconds && steps < maxSteps) {
+            accumulator -= stepSeconds;
+            ++steps;
+        }
+        if (accumulator >= stepSeconds) {
+            accumulator = std::fmod(accumulator, stepSeconds);
+        }
+        return steps;
+    }
+
+    // 0 = the state before the last step, 1 = the state after it.
+    float getAlpha() const { return static_cast<float>(accumulator / stepSeconds); }
+
+private:
+    double stepSeconds = 1.0 / DEFAULT_RATE;
+    double accumulator = 0.0; // Frame time not yet simulated
+    int maxSteps = DEFAULT_MAX_STEPS;
+};
+
+#endif
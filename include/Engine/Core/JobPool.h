@@ -0,0 +1,212 @@
+#ifndef JOBPOOL_H
+#define JOBPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads that execute queued jobs.
+ *        Every worker has its own queue: jobs submitted from a worker go to that worker's queue
+ *        and are taken newest first, an idle worker steals the oldest job of another queue.
+ *        parallelFor() splits a range into fixed-size batches which the calling thread and the
+ *        workers claim one at a time, so batch boundaries never depend on the thread count.
+ */
+class JobPool {
+public:
+    // One worker per hardware thread, minus the thread that calls parallelFor().
+    static unsigned defaultWorkerCount() {
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    explicit JobPool(unsigned workerCount = defaultWorkerCount()) {
+        queues.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~JobPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
+    }
+
+    JobPool(const JobPool &) = delete;
+    JobPool &operator=(const JobPool &) = delete;
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    /**
+     * @brief Queues a job for the workers. Runs it immediately if there are none.
+     */
+    void submit(std::function<void()> job) {
+        if (workers.empty()) {
+            job();
+            return;
+        }
+
+        // Workers keep their own jobs local, other threads spread them round-robin.
+        std::size_t index = currentPool == this ? currentWorker : nextQueue.fetch_add(1) % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->jobs.push_back(std::move(job));
+        }
+        pending.fetch_add(1);
+
+        // Taking the lock orders this with a worker that is about to sleep, so the wake-up isn't lost.
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_one();
+    }
+
+    /**
+     * @brief Runs one queued job on the calling thread, if there is one.
+     *        Lets a thread that waits for jobs help out instead of idling.
+     * @return False if every queue was empty.
+     */
+    bool runPending() {
+        if (workers.empty()) return false;
+
+        std::function<void()> job;
+        if (!take(currentPool == this ? currentWorker : 0, job)) return false;
+        job();
+        return true;
+    }
+
+    /**
+     * @brief Calls fn(begin, end) for every batch of [0, count) and returns once all have run.
+     *        Batches are [0, batchSize), [batchSize, 2 * batchSize), ... regardless of how many
+     *        threads take part. The calling thread works on batches too.
+     */
+    template<typename Fn>
+    void parallelFor(std::size_t count, std::size_t batchSize, Fn &&fn) {
+        if (count == 0) return;
+        batchSize = std::max<std::size_t>(batchSize, 1);
+        std::size_t batches = (count + batchSize - 1) / batchSize;
+
+        if (batches == 1 || workers.empty()) {
+            for (std::size_t begin = 0; begin < count; begin += batchSize) {
+                fn(begin, std::min(begin + batchSize, count));
+            }
+            return;
+        }
+
+        // Shared so helpers that only start after the loop finished can still look at it safely.
+        struct Loop {
+            std::atomic<std::size_t> next{0};
+            std::atomic<std::size_t> done{0};
+            std::size_t batches = 0;
+            std::size_t count = 0;
+            std::size_t batchSize = 0;
+            std::function<void(std::size_t, std::size_t)> body;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+
+        auto loop = std::make_shared<Loop>();
+        loop->batches = batches;
+        loop->count = count;
+        loop->batchSize = batchSize;
+        loop->body = [&fn](std::size_t begin, std::size_t end) { fn(begin, end); };
+
+        auto work = [](const std::shared_ptr<Loop> &state) {
+            for (;;) {
+                std::size_t batch = state->next.fetch_add(1);
+                if (batch >= state->batches) return;
+
+                std::size_t begin = batch * state->batchSize;
+                state->body(begin, std::min(begin + state->batchSize, state->count));
+
+                if (state->done.fetch_add(1) + 1 == state->batches) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        std::size_t helpers = std::min<std::size_t>(workers.size(), batches - 1);
+        for (std::size_t i = 0; i < helpers; ++i) {
+            submit([loop, work] { work(loop); });
+        }
+
+        work(loop);
+
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->finished.wait(lock, [&] { return loop->done.load() == loop->batches; });
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()> > jobs;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue> > queues; // One per worker
+    std::atomic<std::size_t> pending{0}; // Jobs across all queues
+    std::atomic<std::size_t> nextQueue{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    // Which pool and queue the current thread works for, if it is a worker.
+    inline static thread_local const JobPool *currentPool = nullptr;
+    inline static thread_local std::size_t currentWorker = 0;
+
+    // Pops the newest job of queue 'home', or steals the oldest job of another queue.
+    bool take(std::size_t home, std::function<void()> &job) {
+        for (std::size_t n = 0; n < queues.size(); ++n) {
+            std::size_t index = (home + n) % queues.size();
+            Queue &queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.jobs.empty()) continue;
+
+            if (n == 0) {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+            } else {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            }
+            pending.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t index) {
+        currentPool = this;
+        currentWorker = index;
+
+        for (;;) {
+            std::function<void()> job;
+            if (take(index, job)) {
+                job();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] { return stopping || pending.load() > 0; });
+            if (stopping && pending.load() == 0) return;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+/**
+ * @brief Leveled logging that never blocks the calling thread on console output.
+ *        LOG_INFO("Map loaded: " << filename); formats the line into a fixed-size buffer on the
+ *        calling thread and pushes it to a lock-free ring buffer, a background thread writes the lines
+ *        out (warnings and errors to std::cerr, the rest to std::cout). When the buffer is full the line
+ *        is dropped and counted instead of waiting.
+ *        Levels below ISKOBR_LOG_LEVEL are compiled out completely, their arguments are never evaluated.
+ *        Above that, setLevel() filters at runtime.
+ */
+
+// 0 = trace, 1 = debug, 2 = info, 3 = warn, 4 = error. Debug builds keep debug lines, release builds start at info.
+#ifndef ISKOBR_LOG_LEVEL
+#ifdef NDEBUG
+#define ISKOBR_LOG_LEVEL 2
+#else
+#define ISKOBR_LOG_LEVEL 1
+#endif
+#endif
+
+class Log {
+public:
+    enum class Level : std::uint8_t { Trace, Debug, Info, Warn, Error };
+
+    static constexpr std::size_t CAPACITY = 1024; // Lines, must be a power of two
+    static constexpr std::size_t LINE_SIZE = 240; // Longer lines are cut off
+
+    static void setLevel(Level level) { sink().minimum.store(level, std::memory_order_relaxed); }
+
+    static bool enabled(Level level) {
+        return static_cast<int>(level) >= ISKOBR_LOG_LEVEL && level >= sink().minimum.load(std::memory_order_relaxed);
+    }
+
+    // Waits until every line logged so far has been written out.
+    static void flush() {
+        Sink &s = sink();
+        std::uint64_t target = s.head.load(std::memory_order_acquire);
+        while (s.written.load(std::memory_order_acquire) < target) {
+            s.wake();
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    // Formats straight into a fixed per-thread array, so logging never allocates.
+    struct LineBuffer : std::streambuf {
+        char line[LINE_SIZE];
+
+        void reset() { setp(line, line + LINE_SIZE); }
+        const char *data() const { return pbase(); }
+        std::size_t size() const { return static_cast<std::size_t>(pptr() - pbase()); }
+
+    protected:
+        int_type overflow(int_type) override { return traits_type::eof(); }
+    };
+
+public:
+    /**
+     * @brief One line being formatted, pushed when it goes out of scope. Used by the LOG_* macros.
+     */
+    class Line {
+    public:
+        explicit Line(Level level) : level(level), buffer(threadBuffer()), stream(threadStream()) {
+            buffer.reset();
+            stream.clear();
+        }
+
+        ~Line() { sink().push(level, buffer.data(), buffer.size()); }
+
+        Line(const Line &) = delete;
+        Line &operator=(const Line &) = delete;
+
+        std::ostream &get() { return stream; }
+
+    private:
+        Level level;
+        LineBuffer &buffer;
+        std::ostream &stream;
+
+        static LineBuffer &threadBuffer() {
+            thread_local LineBuffer lineBuffer;
+            return lineBuffer;
+        }
+
+        static std::ostream &threadStream() {
+            thread_local std::ostream lineStream(&threadBuffer());
+            return lineStream;
+        }
+    };
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;
+        Level level;
+        std::uint16_t length;
+        char text[LINE_SIZE];
+    };
+
+    // Bounded multi-producer/single-consumer queue: a slot is free for position p while its sequence is p
+    // and holds the line for p once its sequence is p + 1.
+    struct Sink {
+        std::atomic<Level> minimum{Level::Trace};
+        std::atomic<std::uint64_t> head{0}; // Next position to claim
+        std::atomic<std::uint64_t> written{0}; // Lines the writer thread is done with
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint32_t> signal{0};
+        std::atomic<bool> running{true};
+        Slot slots[CAPACITY];
+        std::thread writer;
+
+        Sink() {
+            for (std::size_t i = 0; i < CAPACITY; ++i) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            writer = std::thread([this] { writerLoop(); });
+        }
+
+        ~Sink() {
+            running.store(false, std::memory_order_release);
+            wake();
+            writer.join();
+        }
+
+        void push(Level level, const char *text, std::size_t length) {
+            std::uint64_t position = head.load(std::memory_order_relaxed);
+            Slot *slot;
+            for (;;) {
+                slot = &slots[position & (CAPACITY - 1)];
+                std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::int64_t>(sequence - position);
+                if (difference == 0) {
+                    if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    dropped.fetch_add(1, std::memory_order_relaxed); // Full, the writer is behind
+                    return;
+                } else {
+                    position = head.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->level = level;
+            slot->length = static_cast<std::uint16_t>(length);
+            std::char_traits<char>::copy(slot->text, text, length);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            wake();
+        }
+
+        void wake() {
+            signal.fetch_add(1, std::memory_order_release);
+            signal.notify_one();
+        }
+
+        void writerLoop() {
+            std::uint64_t tail = 0;
+            for (;;) {
+                std::uint32_t seen = signal.load(std::memory_order_acquire);
+                bool wroteOut = false;
+                bool wroteError = false;
+
+                for (;;) {
+                    Slot &slot = slots[tail & (CAPACITY - 1)];
+                    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) break;
+
+                    bool error = slot.level >= Level::Warn;
+                    std::ostream &out = error ? std::cerr : std::cout;
+                    out << prefix(slot.level);
+                    out.write(slot.text, slot.length);
+                    out << '\n';
+                    if (error) {
+                        wroteError = true;
+                    } else {
+                        wroteOut = true;
+                    }
+
+                    slot.sequence.store(tail + CAPACITY, std::memory_order_release);
+                    written.store(++tail, std::memory_order_release);
+                }
+
+                if (std::uint64_t lost = dropped.exchange(0, std::memory_order_relaxed)) {
+                    std::cerr << "[warn] " << lost << " log lines dropped, the log buffer was full\n";
+                    wroteError = true;
+                }
+                if (wroteOut) std::cout.flush();
+                if (wroteError) std::cerr.flush();
+
+                if (!running.load(std::memory_order_acquire) && head.load(std::memory_order_acquire) == tail) return;
+                signal.wait(seen, std::memory_order_acquire);
+            }
+        }
+
+        static const char *prefix(Level level) {
+            switch (level) {
+                case Level::Trace: return "[trace] ";
+                case Level::Debug: return "[debug] ";
+                case Level::Info: return "[info] ";
+                case Level::Warn: return "[warn] ";
+                case Level::Error: return "[error] ";
+            }
+            return "";
+        }
+    };
+
+    static Sink &sink() {
+        static Sink instance;
+        return instance;
+    }
+};
+
+#define ISKOBR_LOG_AT(level, message) \
+    do { \
+        if (::Log::enabled(level)) { \
+            ::Log::Line logLine(level); \
+            logLine.get() << message; \
+        } \
+    } while (false)
+
+#if ISKOBR_LOG_LEVEL <= 0
+#define LOG_TRACE(message) ISKOBR_LOG_AT(::Log::Level::Trace, message)
+#else
+#define LOG_TRACE(message) ((void)0)
+#endif
+
+#if ISKOBR_LOG_LEVEL <= 1
+#define LOG_DEBUG(message) ISKOBR_LOG_AT(::Log::Level::Debug, message)
+#else
+#define LOG_DEBUG(message) ((void)0)
+#endif
+
+#if ISKOBR_LOG_LEVEL <= 2
+#define LOG_INFO(message) ISKOBR_LOG_AT(::Log::Level::Info, message)
+#else
+#define LOG_INFO(message) ((void)0)
+#endif
+
+#if ISKOBR_LOG_LEVEL <= 3
+#define LOG_WARN(message) ISKOBR_LOG_AT(::Log::Level::Warn, message)
+#else
+#define LOG_WARN(message) ((void)0)
+#endif
+
+#define LOG_ERROR(message) ISKOBR_LOG_AT(::Log::Level::Error, message)
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief A whole file mapped read-only into memory, pages are loaded by the OS as they are touched.
+ *        Unmapped when the object is destroyed.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Maps the file, replacing any file mapped before.
+     * @return False if it does not exist, cannot be read or is empty.
+     */
+    bool open(const std::string &path);
+
+    void close();
+
+    const unsigned char *data() const { return bytes; }
+    std::size_t size() const { return length; }
+    bool isOpen() const { return bytes != nullptr; }
+
+private:
+    const unsigned char *bytes = nullptr;
+    std::size_t length = 0;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Engine/ComponentManager.h"
+#include "Engine/EntityManager.h"
+#include "Engine/Core/ComponentType.h"
+#include "Engine/Components/Position.h"
+
+class IPrefabComponent {
+public:
+    virtual ~IPrefabComponent() = default;
+
+    virtual ComponentType type() const = 0;
+
+    virtual void cloneTo(Entity entity, ComponentManager &components) const = 0;
+};
+
+template<typename T>
+class PrefabComponent : public IPrefabComponent {
+public:
+    explicit PrefabComponent(T component) : component(std::move(component)) {
+    }
+
+    ComponentType type() const override { return componentType<T>(); }
+
+    void cloneTo(Entity entity, ComponentManager &components) const override {
+        components.insertComponent<T>(entity, component);
+    }
+
+    T component;
+};
+
+/**
+ * @brief A named set of ready-made components that entities are stamped out from.
+ *        The components are built once, usually from an entity file by the PrefabManager. cloneTo()
+ *        then only copies each of them into its pool and sets the entity's whole signature at once,
+ *        so the new entity joins all of its systems in a single pass instead of one per component.
+ */
+class Prefab {
+public:
+    explicit Prefab(std::string name) : name(std::move(name)) {
+    }
+
+    const std::string &getName() const { return name; }
+
+    Signature getSignature() const { return signature; }
+
+    // Adds the component, or replaces the prefab's component of the same type.
+    template<typename T>
+    void set(T component) {
+        if (PrefabComponent<T> *part = findPart<T>()) {
+            part->component = std::move(component);
+            return;
+        }
+        parts.push_back(std::make_unique<PrefabComponent<T> >(std::move(component)));
+        signature.set(componentType<T>());
+    }
+
+    // The prefab's component of type T, nullptr when it has none.
+    template<typename T>
+    const T *find() const {
+        const PrefabComponent<T> *part = findPart<T>();
+        return part ? &part->component : nullptr;
+    }
+
+    // Where the prefab places entities when no position is given.
+    Position getPosition() const {
+        const Position *position = find<Position>();
+        return position ? *position : Position{};
+    }
+
+    /**
+     * @brief Copies the prefab's components onto an entity and places it at 'position'.
+     * @param entity A freshly created entity without components.
+     */
+    void cloneTo(Entity entity, ComponentManager &components, Position position) const {
+        for (const auto &part: parts) {
+            part->cloneTo(entity, components);
+        }
+        components.insertComponent<Position>(entity, position);
+
+        Signature entitySignature = signature;
+        entitySignature.set(componentType<Position>());
+        components.setSignature(entity, entitySignature);
+    }
+
+private:
+    std::string name;
+    Signature signature; // Types of the components in 'parts'
+    std::vector<std::unique_ptr<IPrefabComponent> > parts;
+
+    template<typename T>
+    PrefabComponent<T> *findPart() const {
+        if (!signature.test(componentType<T>())) return nullptr;
+        for (const auto &part: parts) {
+            if (part->type() == componentType<T>()) return static_cast<PrefabComponent<T> *>(part.get());
+        }
+        return nullptr;
+    }
+};
+
+#endif
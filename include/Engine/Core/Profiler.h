@@ -0,0 +1,203 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Records how long named sections (one per system, plus render) take each frame.
+ *        Sections are timed with ProfileScope from any thread: every sample is one slot of a
+ *        fixed-size ring buffer claimed with a single atomic increment, nothing is locked or allocated.
+ *        endFrame() sums the frame's samples per section into a history of the last FRAME_HISTORY frames,
+ *        which the overlay draws and writeCsv() exports. writeChromeTrace() exports the raw samples
+ *        still in the buffer for chrome://tracing or ui.perfetto.dev.
+ *        NOTE: addSection(), beginFrame()/endFrame() and the exports belong to the main thread, and
+ *        must not overlap with sections being recorded on other threads.
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t FRAME_HISTORY = 240;
+    static constexpr std::size_t MAX_SAMPLES = 1 << 16;
+
+    struct SectionStats {
+        double milliseconds = 0.0;
+        std::size_t entities = 0; // Largest entity count seen this frame
+        std::uint32_t calls = 0; // More than one when the frame ran several fixed steps
+    };
+
+    struct FrameStats {
+        std::uint64_t index = 0;
+        double milliseconds = 0.0;
+        std::vector<SectionStats> sections; // Indexed by section id
+    };
+
+    Profiler() : samples(std::make_unique<Sample[]>(MAX_SAMPLES)) {
+    }
+
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    std::size_t addSection(std::string name) {
+        sectionNames.push_back(std::move(name));
+        return sectionNames.size() - 1;
+    }
+
+    std::size_t getSectionCount() const { return sectionNames.size(); }
+    const std::string &getSectionName(std::size_t section) const { return sectionNames[section]; }
+
+    void setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void beginFrame() {
+        frameStart = Clock::now();
+        frameFirstSample = sampleCount.load(std::memory_order_relaxed);
+    }
+
+    void endFrame() {
+        if (!isEnabled()) return;
+
+        FrameStats &frame = frames[nextFrame % FRAME_HISTORY];
+        frame.index = nextFrame++;
+        frame.milliseconds = toMilliseconds(Clock::now() - frameStart);
+        frame.sections.assign(sectionNames.size(), {});
+
+        // Samples past MAX_SAMPLES in one frame have overwritten the oldest ones.
+        std::uint64_t end = sampleCount.load(std::memory_order_relaxed);
+        std::uint64_t begin = std::max(frameFirstSample, end > MAX_SAMPLES ? end - MAX_SAMPLES : 0);
+        for (std::uint64_t i = begin; i < end; ++i) {
+            const Sample &sample = samples[i % MAX_SAMPLES];
+            SectionStats &stats = frame.sections[sample.section];
+            stats.milliseconds += toMilliseconds(sample.end - sample.start);
+            stats.entities = std::max(stats.entities, sample.entities);
+            ++stats.calls;
+        }
+    }
+
+    // Stores one timed run of a section, callable from any thread.
+    void record(std::size_t section, Clock::time_point start, Clock::time_point end, std::size_t entities) {
+        std::uint64_t slot = sampleCount.fetch_add(1, std::memory_order_relaxed);
+        samples[slot % MAX_SAMPLES] = {start, end, static_cast<std::uint32_t>(section), threadIndex(), entities};
+    }
+
+    std::size_t getFrameCount() const { return static_cast<std::size_t>(std::min<std::uint64_t>(nextFrame, FRAME_HISTORY)); }
+
+    // 0 = the last finished frame, 1 = the one before it, ...
+    const FrameStats &getFrame(std::size_t ago) const {
+        return frames[(nextFrame - 1 - ago) % FRAME_HISTORY];
+    }
+
+    /**
+     * @brief One row per section per frame in the history, oldest frame first.
+     */
+    bool writeCsv(const std::string &path) const {
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
+
+        file << "frame,frame_ms,section,ms,calls,entities\n";
+        for (std::size_t ago = getFrameCount(); ago-- > 0;) {
+            const FrameStats &frame = getFrame(ago);
+            for (std::size_t section = 0; section < frame.sections.size(); ++section) {
+                const SectionStats &stats = frame.sections[section];
+                if (stats.calls == 0) continue;
+                file << frame.index << ',' << frame.milliseconds << ',' << sectionNames[section] << ','
+                        << stats.milliseconds << ',' << stats.calls << ',' << stats.entities << '\n';
+            }
+        }
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief Every sample still in the ring buffer as a Chrome trace-event "complete" event,
+     *        one track per thread.
+     */
+    bool writeChromeTrace(const std::string &path) const {
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
+
+        std::uint64_t end = sampleCount.load(std::memory_order_relaxed);
+        std::uint64_t begin = end > MAX_SAMPLES ? end - MAX_SAMPLES : 0;
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (std::uint64_t i = begin; i < end; ++i) {
+            const Sample &sample = samples[i % MAX_SAMPLES];
+            if (i != begin) file << ',';
+            file << "\n{\"name\":\"" << sectionNames[sample.section] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+                    << sample.thread << ",\"ts\":" << toMicroseconds(sample.start - origin)
+                    << ",\"dur\":" << toMicroseconds(sample.end - sample.start)
+                    << ",\"args\":{\"entities\":" << sample.entities << "}}";
+        }
+        file << "\n]}\n";
+        return static_cast<bool>(file);
+    }
+
+private:
+    struct Sample {
+        Clock::time_point start;
+        Clock::time_point end;
+        std::uint32_t section;
+        std::uint32_t thread;
+        std::size_t entities;
+    };
+
+    std::vector<std::string> sectionNames;
+    std::atomic<bool> enabled{true};
+
+    std::unique_ptr<Sample[]> samples;
+    std::atomic<std::uint64_t> sampleCount{0};
+
+    FrameStats frames[FRAME_HISTORY];
+    std::uint64_t nextFrame = 0;
+    std::uint64_t frameFirstSample = 0;
+    Clock::time_point frameStart = Clock::now();
+    Clock::time_point origin = Clock::now();
+
+    static double toMilliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    static double toMicroseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    // Small stable number per thread, the trace's track id.
+    static std::uint32_t threadIndex() {
+        static std::atomic<std::uint32_t> nextThread{0};
+        thread_local std::uint32_t index = nextThread.fetch_add(1);
+        return index;
+    }
+};
+
+/**
+ * @brief Times the enclosing scope as one sample of a section. Does nothing without an enabled profiler.
+ */
+class ProfileScope {
+public:
+    ProfileScope(Profiler *profiler, std::size_t section, std::size_t entities = 0)
+        : profiler(profiler && profiler->isEnabled() ? profiler : nullptr), section(section), entities(entities) {
+        if (this->profiler) start = Profiler::Clock::now();
+    }
+
+    ~ProfileScope() {
+        if (profiler) profiler->record(section, start, Profiler::Clock::now(), entities);
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    Profiler *profiler;
+    std::size_t section;
+    std::size_t entities;
+    Profiler::Clock::time_point start;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/Profiler.h"
+
+/**
+ * @brief Draws the profiler's frame history in screen space.
+ *        A stacked bar per frame (one color per section, grey for time outside any section) with a
+ *        line at the 60 fps budget, and below it one row per section with its average time.
+ *        Section names and numbers need a font, see loadFont(); without one only the bars are drawn.
+ */
+class ProfilerOverlay : public sf::Drawable {
+public:
+    static constexpr float BAR_WIDTH = 2.f;
+    static constexpr float GRAPH_HEIGHT = 160.f;
+    static constexpr double GRAPH_MILLISECONDS = 1000.0 / 30.0; // Time at the top of the graph
+    static constexpr double BUDGET_MILLISECONDS = 1000.0 / 60.0;
+    static constexpr float ROW_HEIGHT = 16.f;
+    static constexpr float PIXELS_PER_MILLISECOND = 60.f; // Width of the average bars
+
+    explicit ProfilerOverlay(const Profiler &profiler) : profiler(profiler) {
+    }
+
+    bool loadFont(const std::string &path) {
+        hasFont = font.loadFromFile(path);
+        return hasFont;
+    }
+
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+protected:
+    void draw(sf::RenderTarget &target, sf::RenderStates states) const override {
+        if (!visible || profiler.getFrameCount() == 0) return;
+
+        const sf::Vector2f origin{10.f, 10.f};
+        const std::size_t frameCount = profiler.getFrameCount();
+        const std::size_t sectionCount = profiler.getSectionCount();
+        const float graphWidth = Profiler::FRAME_HISTORY * BAR_WIDTH;
+        const float msToPixels = GRAPH_HEIGHT / static_cast<float>(GRAPH_MILLISECONDS);
+
+        sf::VertexArray quads(sf::Quads);
+        float tableHeight = sectionCount * ROW_HEIGHT + 8.f;
+        addRect(quads, origin.x - 4.f, origin.y - 4.f, graphWidth + 8.f, GRAPH_HEIGHT + tableHeight + 8.f,
+                sf::Color(0, 0, 0, 170));
+
+        // Frame history, oldest on the left
+        float bottom = origin.y + GRAPH_HEIGHT;
+        for (std::size_t ago = 0; ago < frameCount; ++ago) {
+            const Profiler::FrameStats &frame = profiler.getFrame(ago);
+            float x = origin.x + graphWidth - (ago + 1) * BAR_WIDTH;
+            float y = bottom;
+            double sectionsMs = 0.0;
+            for (std::size_t section = 0; section < frame.sections.size(); ++section) {
+                double ms = frame.sections[section].milliseconds;
+                sectionsMs += ms;
+                y = addBarSegment(quads, x, y, ms * msToPixels, origin.y, colorOf(section));
+            }
+            addBarSegment(quads, x, y, std::max(0.0, frame.milliseconds - sectionsMs) * msToPixels, origin.y,
+                          sf::Color(110, 110, 110));
+        }
+        float budgetY = bottom - static_cast<float>(BUDGET_MILLISECONDS) * msToPixels;
+        addRect(quads, origin.x, budgetY, graphWidth, 1.f, sf::Color::White);
+
+        // Per section averages over the history
+        std::vector<sf::Text> labels;
+        for (std::size_t section = 0; section < sectionCount; ++section) {
+            double total = 0.0;
+            double worst = 0.0;
+            std::size_t entities = 0;
+            for (std::size_t ago = 0; ago < frameCount; ++ago) {
+                const Profiler::FrameStats &frame = profiler.getFrame(ago);
+                if (section >= frame.sections.size()) continue;
+                total += frame.sections[section].milliseconds;
+                worst = std::max(worst, frame.sections[section].milliseconds);
+                entities = std::max(entities, frame.sections[section].entities);
+            }
+            double average = total / frameCount;
+
+            float rowY = bottom + 8.f + section * ROW_HEIGHT;
+            addRect(quads, origin.x, rowY + 3.f, 10.f, 10.f, colorOf(section));
+            float barWidth = std::min(static_cast<float>(average) * PIXELS_PER_MILLISECOND, graphWidth / 2.f);
+            addRect(quads, origin.x + graphWidth / 2.f, rowY + 5.f, std::max(barWidth, 1.f), 6.f, colorOf(section));
+
+            if (hasFont) {
+                char line[128];
+                std::snprintf(line, sizeof(line), "%-24s %6.3f ms  max %6.3f  %zu",
+                              profiler.getSectionName(section).c_str(), average, worst, entities);
+                sf::Text text(line, font, 12);
+                text.setPosition(origin.x + 14.f, rowY);
+                text.setFillColor(sf::Color::White);
+                labels.push_back(std::move(text));
+            }
+        }
+
+        target.draw(quads, states);
+        for (const sf::Text &label: labels) {
+            target.draw(label, states);
+        }
+    }
+
+private:
+    const Profiler &profiler;
+    sf::Font font;
+    bool hasFont = false;
+    bool visible = false;
+
+    static sf::Color colorOf(std::size_t section) {
+        static const sf::Color palette[] = {
+            {230, 25, 75}, {60, 180, 75}, {255, 225, 25}, {0, 130, 200}, {245, 130, 48}, {145, 30, 180},
+            {70, 240, 240}, {240, 50, 230}, {210, 245, 60}, {250, 190, 212}, {0, 128, 128}, {220, 190, 255},
+            {170, 110, 40}, {255, 250, 200}, {128, 0, 0}, {170, 255, 195}, {128, 128, 0}, {255, 215, 180},
+        };
+        return palette[section % (sizeof(palette) / sizeof(palette[0]))];
+    }
+
+    static void addRect(sf::VertexArray &quads, float x, float y, float width, float height, sf::Color color) {
+        quads.append(sf::Vertex({x, y}, color));
+        quads.append(sf::Vertex({x + width, y}, color));
+        quads.append(sf::Vertex({x + width, y + height}, color));
+        quads.append(sf::Vertex({x, y + height}, color));
+    }
+
+    // Stacks a segment of 'height' pixels on top of y, clipped at top. Returns the new top.
+    static float addBarSegment(sf::VertexArray &quads, float x, float y, double height, float top, sf::Color color) {
+        float newY = std::max(top, y - static_cast<float>(height));
+        if (newY < y) addRect(quads, x, newY, BAR_WIDTH, y - newY, color);
+        return newY;
+    }
+};
+
+#endif
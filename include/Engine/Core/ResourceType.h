@@ -0,0 +1,36 @@
+#ifndef RESOURCETYPE_H
+#define RESOURCETYPE_H
+
+#include <atomic>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+
+// Resource type ID. Resources are shared state outside the component pools (a particle pool,
+// the camera view...) that systems declare access to, identified by any C++ type.
+using ResourceType = std::uint8_t;
+
+// Maximum number of distinct resource types
+constexpr ResourceType MAX_RESOURCES = 32;
+
+// Bitmask of resource types, one bit per ResourceType.
+using ResourceSet = std::bitset<MAX_RESOURCES>;
+
+/**
+ * @brief Hands out sequential resource type IDs, one per type,
+ *        assigned the first time each type is used.
+ */
+inline ResourceType nextResourceType() {
+    static std::atomic<ResourceType> counter{0};
+    ResourceType type = counter.fetch_add(1);
+    assert(type < MAX_RESOURCES && "Too many resource types.");
+    return type;
+}
+
+template<typename T>
+ResourceType resourceType() {
+    static const ResourceType type = nextResourceType();
+    return type;
+}
+
+#endif
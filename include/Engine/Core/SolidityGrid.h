@@ -0,0 +1,63 @@
+#ifndef SOLIDITYGRID_H
+#define SOLIDITYGRID_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief Baked map of which tiles are solid, used for point queries.
+ *        Cell (x, y) is solid over the rectangle [origin + (x, y) * pitch, + solidSize),
+ *        which mirrors the (inset) collider of that tile. All solid tiles must share
+ *        the same collider, and it must fit within one pitch.
+ */
+class SolidityGrid {
+public:
+    SolidityGrid() = default;
+
+    SolidityGrid(int width, int height, sf::Vector2f origin, sf::Vector2f pitch, sf::Vector2f solidSize)
+        : width(width), height(height), origin(origin), pitch(pitch), solidSize(solidSize),
+          cells(static_cast<std::size_t>(width) * height, 0) {
+    }
+
+    bool empty() const { return cells.empty(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    void setSolid(int x, int y, bool solid) {
+        if (x < 0 || y < 0 || x >= width || y >= height) return;
+        cells[static_cast<std::size_t>(y) * width + x] = solid ? 1 : 0;
+    }
+
+    bool isSolid(int x, int y) const {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        return cells[static_cast<std::size_t>(y) * width + x] != 0;
+    }
+
+    // True if the world point lies inside the collider of a solid tile.
+    bool isSolidAt(float worldX, float worldY) const {
+        if (cells.empty()) return false;
+
+        float localX = worldX - origin.x;
+        float localY = worldY - origin.y;
+        int x = static_cast<int>(std::floor(localX / pitch.x));
+        int y = static_cast<int>(std::floor(localY / pitch.y));
+
+        // Reject the inset strip of the cell that the collider does not cover.
+        if (localX - x * pitch.x >= solidSize.x) return false;
+        if (localY - y * pitch.y >= solidSize.y) return false;
+
+        return isSolid(x, y);
+    }
+
+private:
+    int width = 0;
+    int height = 0;
+    sf::Vector2f origin; // World position of the collider of tile (0, 0)
+    sf::Vector2f pitch; // Distance between neighbouring tiles
+    sf::Vector2f solidSize; // Size of each tile's collider
+    std::vector<std::uint8_t> cells; // 1 = solid, row-major
+};
+
+#endif
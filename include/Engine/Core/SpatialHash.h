@@ -0,0 +1,103 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+using Entity = std::uint32_t;
+
+/**
+ * @brief Uniform grid broad-phase. Entities are bucketed into every square cell
+ *        their bounds overlap, and a query returns the entities sharing a cell
+ *        with the queried area, which is a superset of the ones actually intersecting it.
+ */
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize) : cellSize(cellSize) {
+    }
+
+    void setCellSize(float size) {
+        cellSize = size;
+        cells.clear();
+    }
+
+    float getCellSize() const { return cellSize; }
+
+    // Empties every cell but keeps their storage around for the next rebuild.
+    void clear() {
+        for (auto &[_, cell]: cells) {
+            cell.clear();
+        }
+    }
+
+    void insert(Entity entity, const sf::FloatRect &bounds) {
+        forEachCell(bounds, [&](std::uint64_t key) {
+            cells[key].push_back(entity);
+        });
+    }
+
+    // Moves an entity inserted with 'from' to the cells of 'to'.
+    void move(Entity entity, const sf::FloatRect &from, const sf::FloatRect &to) {
+        if (cellRange(from) == cellRange(to)) return;
+        forEachCell(from, [&](std::uint64_t key) {
+            auto it = cells.find(key);
+            if (it == cells.end()) return;
+            auto &cell = it->second;
+            auto found = std::find(cell.begin(), cell.end(), entity);
+            if (found != cell.end()) {
+                *found = cell.back();
+                cell.pop_back();
+            }
+        });
+        insert(entity, to);
+    }
+
+    // Fills 'out' with the candidates for 'area', sorted by ID and without duplicates.
+    void query(const sf::FloatRect &area, std::vector<Entity> &out) const {
+        out.clear();
+        forEachCell(area, [&](std::uint64_t key) {
+            auto it = cells.find(key);
+            if (it != cells.end()) {
+                out.insert(out.end(), it->second.begin(), it->second.end());
+            }
+        });
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+private:
+    float cellSize;
+    std::unordered_map<std::uint64_t, std::vector<Entity> > cells;
+
+    static std::uint64_t cellKey(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+
+    // First and last cell overlapped by bounds: {minX, minY, maxX, maxY}.
+    std::array<int, 4> cellRange(const sf::FloatRect &bounds) const {
+        return {
+            static_cast<int>(std::floor(bounds.left / cellSize)),
+            static_cast<int>(std::floor(bounds.top / cellSize)),
+            static_cast<int>(std::floor((bounds.left + bounds.width) / cellSize)),
+            static_cast<int>(std::floor((bounds.top + bounds.height) / cellSize))
+        };
+    }
+
+    template<typename Fn>
+    void forEachCell(const sf::FloatRect &bounds, Fn &&fn) const {
+        auto [minX, minY, maxX, maxY] = cellRange(bounds);
+
+        for (int y = minY; y <= maxY; ++y) {
+            for (int x = minX; x <= maxX; ++x) {
+                fn(cellKey(x, y));
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief Collects sprites during a frame and draws them with one draw call per texture.
+ *        Sprites are ordered by their z-order key first (lower is drawn first), then grouped by
+ *        texture. Sprites sharing a key and texture keep the order they were added in.
+ */
+class SpriteBatch {
+public:
+    void clear() {
+        items.clear();
+        textures.clear();
+        batchCount = 0;
+    }
+
+    void add(const sf::Sprite &sprite, int zOrder = 0) {
+        const sf::Texture *texture = sprite.getTexture();
+        if (!texture) return;
+
+        Item item;
+        item.zOrder = zOrder;
+        item.textureSlot = slotFor(texture);
+        item.sequence = static_cast<std::uint32_t>(items.size());
+
+        // Same corners and texture coordinates sf::Sprite builds for itself.
+        const sf::IntRect &rect = sprite.getTextureRect();
+        float width = static_cast<float>(std::abs(rect.width));
+        float height = static_cast<float>(std::abs(rect.height));
+        float left = static_cast<float>(rect.left);
+        float top = static_cast<float>(rect.top);
+        float right = left + rect.width;
+        float bottom = top + rect.height;
+
+        const sf::Transform &transform = sprite.getTransform();
+        const sf::Color &color = sprite.getColor();
+        item.quad[0] = sf::Vertex(transform.transformPoint({0.f, 0.f}), color, {left, top});
+        item.quad[1] = sf::Vertex(transform.transformPoint({width, 0.f}), color, {right, top});
+        item.quad[2] = sf::Vertex(transform.transformPoint({width, height}), color, {right, bottom});
+        item.quad[3] = sf::Vertex(transform.transformPoint({0.f, height}), color, {left, bottom});
+
+        items.push_back(item);
+    }
+
+    /**
+     * @brief Sorts the collected sprites and submits one draw per run of the same z-order and texture.
+     */
+    void draw(sf::RenderTarget &target, sf::RenderStates states = sf::RenderStates::Default) {
+        std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+            return std::tie(a.zOrder, a.textureSlot, a.sequence) < std::tie(b.zOrder, b.textureSlot, b.sequence);
+        });
+
+        batchCount = 0;
+        std::size_t start = 0;
+        while (start < items.size()) {
+            std::size_t end = start;
+            vertices.clear();
+            while (end < items.size() && items[end].zOrder == items[start].zOrder &&
+                   items[end].textureSlot == items[start].textureSlot) {
+                vertices.insert(vertices.end(), std::begin(items[end].quad), std::end(items[end].quad));
+                ++end;
+            }
+
+            states.texture = textures[items[start].textureSlot];
+            target.draw(vertices.data(), vertices.size(), sf::Quads, states);
+            ++batchCount;
+            start = end;
+        }
+    }
+
+    std::size_t getSpriteCount() const { return items.size(); }
+    std::size_t getBatchCount() const { return batchCount; } // Draw calls issued by the last draw()
+
+private:
+    struct Item {
+        int zOrder = 0;
+        std::uint32_t textureSlot = 0;
+        std::uint32_t sequence = 0;
+        sf::Vertex quad[4];
+    };
+
+    std::vector<Item> items;
+    std::vector<const sf::Texture *> textures; // Slot -> texture, in first-seen order for the frame
+    std::vector<sf::Vertex> vertices; // Scratch buffer for the current run
+    std::size_t batchCount = 0;
+
+    std::uint32_t slotFor(const sf::Texture *texture) {
+        for (std::size_t i = 0; i < textures.size(); ++i) {
+            if (textures[i] == texture) return static_cast<std::uint32_t>(i);
+        }
+        textures.push_back(texture);
+        return static_cast<std::uint32_t>(textures.size() - 1);
+    }
+};
+
+#endif
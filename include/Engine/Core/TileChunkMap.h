@@ -0,0 +1,189 @@
+#ifndef TILECHUNKMAP_H
+#define TILECHUNKMAP_H
+
+#include <algorithm>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "Engine/TilesetManager.h"
+
+/**
+ * @brief Render-side storage of a tile map.
+ *        Tiles are grouped into square chunks and each chunk keeps one vertex array per tileset,
+ *        so drawing the map costs a handful of draw calls instead of one per tile.
+ *        A chunk's vertices are only rebuilt after one of its tiles changes.
+ */
+class TileChunkMap : public sf::Drawable {
+public:
+    static constexpr int DEFAULT_CHUNK_SIZE = 16; // In tiles
+
+    struct ChunkLayer {
+        const sf::Texture *texture = nullptr;
+        sf::VertexArray vertices{sf::Quads};
+    };
+
+    struct Chunk {
+        std::vector<ChunkLayer> layers; // One per tileset used in the chunk
+        sf::FloatRect bounds; // World-space area covered by the chunk's tiles
+        bool dirty = false;
+    };
+
+    /**
+     * @brief Clears the map and resizes it to width x height tiles.
+     */
+    void reset(int width, int height, float tileScale, int chunkSize = DEFAULT_CHUNK_SIZE) {
+        this->width = width;
+        this->height = height;
+        this->tileScale = tileScale;
+        this->chunkSize = chunkSize;
+        chunksX = (width + chunkSize - 1) / chunkSize;
+        chunksY = (height + chunkSize - 1) / chunkSize;
+
+        tiles.assign(static_cast<std::size_t>(width) * height, Tile{});
+        chunks.assign(static_cast<std::size_t>(chunksX) * chunksY, Chunk{});
+    }
+
+    /**
+     * @brief Places a tile, or clears the cell when tileset is null. Marks the owning chunk for rebuild.
+     */
+    void setTile(int x, int y, const Tileset *tileset, int tileID) {
+        if (x < 0 || y < 0 || x >= width || y >= height) return;
+
+        Tile &tile = tiles[static_cast<std::size_t>(y) * width + x];
+        if (tile.tileset == tileset && tile.tileID == tileID) return;
+
+        tile.tileset = tileset;
+        tile.tileID = tileID;
+        chunks[static_cast<std::size_t>(y / chunkSize) * chunksX + x / chunkSize].dirty = true;
+    }
+
+    void clearTile(int x, int y) { setTile(x, y, nullptr, -1); }
+
+    /**
+     * @brief Rebuilds the vertex arrays of every chunk whose tiles changed since the last call.
+     */
+    void rebuildDirtyChunks() {
+        for (int cy = 0; cy < chunksY; ++cy) {
+            for (int cx = 0; cx < chunksX; ++cx) {
+                Chunk &chunk = chunks[static_cast<std::size_t>(cy) * chunksX + cx];
+                if (chunk.dirty) {
+                    buildChunk(chunk, cx, cy);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Draws only the chunks whose bounds intersect area.
+     * @return The number of non-empty chunks that were skipped.
+     */
+    std::size_t drawVisible(sf::RenderTarget &target, const sf::FloatRect &area,
+                            sf::RenderStates states = sf::RenderStates::Default) const {
+        std::size_t culled = 0;
+        for (const Chunk &chunk: chunks) {
+            if (chunk.layers.empty()) continue;
+            if (!chunk.bounds.intersects(area)) {
+                ++culled;
+                continue;
+            }
+            for (const ChunkLayer &layer: chunk.layers) {
+                states.texture = layer.texture;
+                target.draw(layer.vertices, states);
+            }
+        }
+        return culled;
+    }
+
+    const std::vector<Chunk> &getChunks() const { return chunks; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+protected:
+    void draw(sf::RenderTarget &target, sf::RenderStates states) const override {
+        for (const Chunk &chunk: chunks) {
+            for (const ChunkLayer &layer: chunk.layers) {
+                states.texture = layer.texture;
+                target.draw(layer.vertices, states);
+            }
+        }
+    }
+
+private:
+    struct Tile {
+        const Tileset *tileset = nullptr;
+        int tileID = -1;
+    };
+
+    int width = 0;
+    int height = 0;
+    int chunkSize = DEFAULT_CHUNK_SIZE;
+    int chunksX = 0;
+    int chunksY = 0;
+    float tileScale = 1.f;
+    std::vector<Tile> tiles; // Row-major, width * height
+    std::vector<Chunk> chunks; // Row-major, chunksX * chunksY
+
+    void buildChunk(Chunk &chunk, int cx, int cy) {
+        chunk.layers.clear();
+        chunk.bounds = {};
+        chunk.dirty = false;
+
+        float left = 0.f, top = 0.f, right = 0.f, bottom = 0.f;
+        bool empty = true;
+
+        int endX = std::min((cx + 1) * chunkSize, width);
+        int endY = std::min((cy + 1) * chunkSize, height);
+        for (int y = cy * chunkSize; y < endY; ++y) {
+            for (int x = cx * chunkSize; x < endX; ++x) {
+                const Tile &tile = tiles[static_cast<std::size_t>(y) * width + x];
+                if (!tile.tileset) continue;
+
+                const Tileset &ts = *tile.tileset;
+                ChunkLayer &layer = layerFor(chunk, ts.region.texture.get());
+
+                // Same placement the per-tile sprites used: centred origin, scaled, offset by half a tile.
+                float tileW = ts.tileWidth * tileScale;
+                float tileH = ts.tileHeight * tileScale;
+                float x0 = x * tileW + ts.tileWidth / 2.f - tileW / 2.f;
+                float y0 = y * tileH + ts.tileHeight / 2.f - tileH / 2.f;
+
+                float u0 = static_cast<float>(ts.region.rect.left + tile.tileID % ts.tilesPerRow * ts.tileWidth);
+                float v0 = static_cast<float>(ts.region.rect.top + tile.tileID / ts.tilesPerRow * ts.tileHeight);
+                float u1 = u0 + ts.tileWidth;
+                float v1 = v0 + ts.tileHeight;
+
+                layer.vertices.append(sf::Vertex({x0, y0}, {u0, v0}));
+                layer.vertices.append(sf::Vertex({x0 + tileW, y0}, {u1, v0}));
+                layer.vertices.append(sf::Vertex({x0 + tileW, y0 + tileH}, {u1, v1}));
+                layer.vertices.append(sf::Vertex({x0, y0 + tileH}, {u0, v1}));
+
+                if (empty) {
+                    left = x0;
+                    top = y0;
+                    right = x0 + tileW;
+                    bottom = y0 + tileH;
+                    empty = false;
+                } else {
+                    left = std::min(left, x0);
+                    top = std::min(top, y0);
+                    right = std::max(right, x0 + tileW);
+                    bottom = std::max(bottom, y0 + tileH);
+                }
+            }
+        }
+
+        if (!empty) {
+            chunk.bounds = {left, top, right - left, bottom - top};
+        }
+    }
+
+    static ChunkLayer &layerFor(Chunk &chunk, const sf::Texture *texture) {
+        for (ChunkLayer &layer: chunk.layers) {
+            if (layer.texture == texture) return layer;
+        }
+        chunk.layers.push_back(ChunkLayer{texture, sf::VertexArray(sf::Quads)});
+        return chunk.layers.back();
+    }
+};
+
+#endif
@@ -2,12 +2,18 @@
 #define UPDATECONTEXT_H
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <vector>
 
 
 
+class CommandBuffer;
 class ComponentManager;
+class EntityManager;
+class JobPool;
 class ParticleSystem;
+class PrefabManager;
+class Profiler;
 class SystemManager;
 
 
@@ -20,6 +26,11 @@ struct UpdateContext {
     sf::RenderWindow* window;
     std::vector<std::shared_ptr<ParticleSystem>> particleSystems;
     std::vector<sf::Drawable*> drawables;
+    JobPool* jobs = nullptr; // Worker threads for data-parallel work, may be null
+    float alpha = 1.f; // Render only: blend between the previous and the current simulation step
+    Profiler* profiler = nullptr; // Times system updates when set
+    CommandBuffer* commands = nullptr; // Entity/component changes applied after the systems ran
+    const PrefabManager* prefabs = nullptr; // Named entity templates, spawn them through 'commands'
 };
 
 #endif
@@ -11,12 +11,20 @@
 #include "Systems/PlayerInputSystem.h"
 #include "Systems/RenderSystem.h"
 #include "SystemManager.h"
+#include "SystemScheduler.h"
 #include "Systems/AnimationSystem.h"
 #include "Systems/CameraSystem.h"
 #include "Systems/CollisionSystem.h"
 #include "Systems/TileMapSystem.h"
 #include "Systems/TriggerSystem.h"
 #include "Engine/TilesetManager.h"
+#include "Engine/PrefabManager.h"
+#include "Engine/TextureCache.h"
+#include "Engine/Core/JobPool.h"
+#include "Engine/Core/CommandBuffer.h"
+#include "Engine/Core/FixedTimestep.h"
+#include "Engine/Core/Profiler.h"
+#include "Engine/Core/ProfilerOverlay.h"
 #include "Systems/ActorSystem.h"
 #include "external/json/json.hpp"
 #include "Systems/AIStateSystem.h"
@@ -42,8 +50,34 @@ class Engine {
 public:
     void run(bool debugMode);
 
+    /**
+     * @brief Runs the simulation for a number of fixed steps without a window.
+     *        No textures are loaded and nothing is drawn, player input is not polled.
+     *        Prints how long the steps took.
+     */
+    void runHeadless(std::size_t ticks);
+
+    // Creates the managers and systems and loads the entities and the level.
+    void setup(bool headless);
+
+    // Advances the simulation by one fixed step, after setup().
+    void step();
+
+    // Per-system timings of the recent frames, after setup().
+    Profiler& getProfiler() { return *profiler; }
+
+    // Writes the profiler's frame history to <prefix>.csv and its trace to <prefix>.json.
+    void writeProfile(const std::string& prefix) const;
+
+    // Simulation rate in steps per second, and how many steps one frame may run to catch up.
+    void setFixedTimestep(float rate, int maxCatchUpSteps = FixedTimestep::DEFAULT_MAX_STEPS) {
+        timestep.setRate(rate);
+        timestep.setMaxSteps(maxCatchUpSteps);
+    }
+
 private:
     sf::RenderWindow window;
+    bool headless = false;
 
     void processEvents();
 
@@ -53,8 +87,13 @@ private:
 
     bool loadEntities(std::string &filepath);
 
+    // Every animation sheet referenced by an entity file, for atlas packing.
+    static std::vector<std::string> animationSheetPaths(const std::string &filepath);
+
     InputManager input;
 
+    FixedTimestep timestep;
+
     Entity playerEntity = InvalidEntity;
 
     std::vector<sf::Drawable*> drawables;
@@ -64,8 +103,16 @@ private:
     std::unique_ptr<EntityManager> entityManager;
     std::unique_ptr<ComponentManager> componentManager;
     std::unique_ptr<SystemManager> systemManager;
+    std::unique_ptr<SystemScheduler> scheduler;
+    std::unique_ptr<TextureCache> textureCache;
     std::unique_ptr<TilesetManager> tilesetManager;
+    std::unique_ptr<PrefabManager> prefabManager;
     std::unique_ptr<sf::Texture> playerTexture;
+    std::unique_ptr<JobPool> jobPool;
+    std::unique_ptr<CommandBuffer> commands;
+    std::unique_ptr<Profiler> profiler;
+    std::unique_ptr<ProfilerOverlay> profilerOverlay; // Toggled with F3, F4 writes the profile
+    std::size_t renderSection = 0;
 
     std::shared_ptr<UpdateContext> ctxt;
     std::shared_ptr<PlayerInputSystem> inputSystem;
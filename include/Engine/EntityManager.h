@@ -1,25 +1,40 @@
 #ifndef ENTITYMANAGER_H
 #define ENTITYMANAGER_H
 
-#include <queue>
-#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <vector>
+
+#include "Engine/Core/ComponentType.h"
 
 // Entity ID type alias
 using Entity = std::uint32_t;
 constexpr Entity InvalidEntity = std::numeric_limits<Entity>::max();
 
-// Maximum entities alllowed in engine
-constexpr Entity MAX_ENTITIES = 5000;
+/**
+ * @brief A reference to an entity that can be kept across frames.
+ *        Entity IDs are recycled, so a stored bare ID may later name an unrelated entity. A handle also
+ *        carries the generation of its ID, which is bumped every time the ID is destroyed, so once the
+ *        entity is gone EntityManager::isAlive(handle) is false for good, even after the ID is reused.
+ */
+struct EntityHandle {
+    Entity index = InvalidEntity;
+    std::uint32_t generation = 0;
+
+    bool operator==(const EntityHandle &) const = default;
+};
+
+constexpr EntityHandle InvalidHandle{};
 
 /**
  * @brief Handles the creation and destruction of entity IDs.
+ *        IDs are minted on demand, so the ID space grows with the number of live entities and
+ *        nothing is filled up front. Destroyed IDs are chained into a free list through their own
+ *        slot and handed out again oldest first.
  */
 class EntityManager {
 public:
-    EntityManager();
-
     /**
      * @brief Creates a new entity ID, will reuse recycled IDs
      *        if available.
@@ -33,9 +48,54 @@ public:
      */
     void destroyEntity(Entity entity);
 
+    /**
+     * @brief Stores the component signature of an entity.
+     * @param entity
+     * @param signature Bitmask of the component types the entity owns.
+     */
+    void setSignature(Entity entity, Signature signature);
+
+    Signature getSignature(Entity entity) const;
+
+    bool isAlive(Entity entity) const;
+
+    /**
+     * @brief Handle to a live entity, for references that outlive the current frame.
+     */
+    EntityHandle getHandle(Entity entity) const;
+
+    // True while the entity the handle was taken from exists, O(1).
+    bool isAlive(EntityHandle handle) const;
+
+    /**
+     * @brief The entity a handle refers to.
+     * @return Its ID, or InvalidEntity once it was destroyed.
+     */
+    Entity resolve(EntityHandle handle) const;
+
+    /**
+     * @brief Number of entity IDs currently in use.
+     */
+    std::size_t getLivingEntityCount() const;
+
+    // Number of IDs minted so far, every live entity is below this.
+    std::size_t getIdCount() const;
+
+    // Makes room for 'count' IDs without reallocating, e.g. before loading a large map.
+    void reserve(std::size_t count);
+
 private:
-    std::queue<Entity> availableEntities; // Queue of unused IDs
-    std::bitset<MAX_ENTITIES> aliveEntities; // Tracks which IDs are currently in use.
+    struct Slot {
+        Signature signature; // Component signature of the entity
+        Entity nextFree = InvalidEntity; // Next ID of the free list while this one is free
+        std::uint32_t generation = 0; // Times this ID has been destroyed
+        bool alive = false;
+    };
+
+    std::vector<Slot> slots; // Indexed by entity ID
+    Entity freeHead = InvalidEntity; // Oldest destroyed ID
+    Entity freeTail = InvalidEntity; // Newest destroyed ID
+    std::size_t livingCount = 0;
 };
 
 #endif
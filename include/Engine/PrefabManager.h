@@ -0,0 +1,255 @@
+#ifndef PREFABMANAGER_H
+#define PREFABMANAGER_H
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/ComponentManager.h"
+#include "Engine/EntityManager.h"
+#include "Engine/TextureCache.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Prefab.h"
+#include "Engine/Components/ActorComponent.h"
+#include "Engine/Components/AIComponent.h"
+#include "Engine/Components/AnimationComponent.h"
+#include "Engine/Components/AttackColliderComponent.h"
+#include "Engine/Components/ColliderComponent.h"
+#include "Engine/Components/DirectionComponent.h"
+#include "Engine/Components/EmitterComponent.h"
+#include "Engine/Components/HealthComponent.h"
+#include "Engine/Components/KnockBackComponent.h"
+#include "Engine/Components/PlayerComponent.h"
+#include "Engine/Components/Position.h"
+#include "Engine/Components/ProjectileComponent.h"
+#include "Engine/Components/SeekComponent.h"
+#include "Engine/Components/SpriteComponent.h"
+#include "Engine/Components/Velocity.h"
+#include "Engine/Components/WallClingComponent.h"
+#include "external/json/json.hpp"
+
+/**
+ * @brief Loads entity files into named prefabs and creates entities from them.
+ *        Every entry of an entity file is parsed once into a Prefab, sprite sheets included, and
+ *        looked up by its "name" (the first entry wins if a name repeats). Entries are also placed in
+ *        the level at their "Position", except those marked "spawn": false, which only define a prefab.
+ */
+class PrefabManager {
+public:
+    PrefabManager(EntityManager &entityManager, ComponentManager &components)
+        : entityManager(entityManager), components(components) {
+    }
+
+    /**
+     * @brief Parses every entry of an entity file into a prefab.
+     * @param textures Where sprite sheets are loaded from, null for headless runs: animations get no frames.
+     * @return False if the file could not be read.
+     */
+    bool loadFile(const std::string &filepath, TextureCache *textures) {
+        std::ifstream file(filepath);
+        if (!file.is_open()) {
+            LOG_ERROR("Failed to open entity file: " << filepath);
+            return false;
+        }
+        nlohmann::json jsonArray;
+        file >> jsonArray;
+
+        for (const auto &j: jsonArray) {
+            auto prefab = std::make_unique<Prefab>(j.at("name").get<std::string>());
+            parse(*prefab, j, textures);
+            LOG_DEBUG("Prefab " << prefab->getName() << ": " << prefab->getSignature().count() << " components");
+
+            byName.emplace(prefab->getName(), prefab.get());
+            if (j.value("spawn", true)) {
+                placements.push_back(prefab.get());
+            }
+            prefabs.push_back(std::move(prefab));
+        }
+        return true;
+    }
+
+    // The prefab loaded under 'name', nullptr if there is none.
+    const Prefab *get(const std::string &name) const {
+        auto it = byName.find(name);
+        return it != byName.end() ? it->second : nullptr;
+    }
+
+    // Entries of the loaded files that are placed in the level, in file order.
+    const std::vector<const Prefab *> &getPlacements() const { return placements; }
+
+    // Creates an entity from the prefab right away. Systems spawn through CommandBuffer::instantiate() instead.
+    Entity instantiate(const Prefab &prefab, Position position) {
+        Entity entity = entityManager.createEntity();
+        prefab.cloneTo(entity, components, position);
+        return entity;
+    }
+
+    Entity instantiate(const Prefab &prefab) {
+        return instantiate(prefab, prefab.getPosition());
+    }
+
+private:
+    EntityManager &entityManager;
+    ComponentManager &components;
+
+    std::vector<std::unique_ptr<Prefab> > prefabs; // Owns every entry, pointers to them stay valid
+    std::unordered_map<std::string, const Prefab *> byName;
+    std::vector<const Prefab *> placements;
+
+    static sf::FloatRect rect(const nlohmann::json &j) {
+        return {j.at("rectLeft").get<float>(), j.at("rectTop").get<float>(),
+                j.at("rectWidth").get<float>(), j.at("rectHeight").get<float>()};
+    }
+
+    // Keys parse() reads. Anything else in an entry is reported instead of being dropped silently.
+    static constexpr std::string_view KNOWN_KEYS[] = {
+        "name", "spawn", "player", "sprite", "health", "ai-sys", "actor", "anim", "spritePath", "Emitter",
+        "Position", "Velocity", "KnockBack", "Direction", "Collision", "AttackCollisionRight",
+        "AttackCollisionLeft", "Projectile"
+    };
+    // Emitters used to be written with these at the top level of the entry.
+    static constexpr std::string_view LEGACY_EMITTER_KEYS[] = {"type", "amount", "active", "EmitterPosition"};
+
+    static bool isOneOf(const std::string &key, const auto &keys) {
+        return std::find(std::begin(keys), std::end(keys), key) != std::end(keys);
+    }
+
+    static void warnUnknownKeys(const Prefab &prefab, const nlohmann::json &j) {
+        bool legacyEmitter = j.contains("EmitterPosition");
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            if (isOneOf(it.key(), KNOWN_KEYS) || (legacyEmitter && isOneOf(it.key(), LEGACY_EMITTER_KEYS))) continue;
+            if (it.key() == "Movement") {
+                LOG_WARN(prefab.getName() << ": \"Movement\" is ignored, entities with a Position and Velocity always move");
+            } else {
+                LOG_WARN(prefab.getName() << ": unknown key \"" << it.key() << "\" ignored");
+            }
+        }
+    }
+
+    static void parse(Prefab &prefab, const nlohmann::json &j, TextureCache *textures) {
+        warnUnknownKeys(prefab, j);
+
+        if (j.contains("Emitter")) {
+            auto &emitterJ = j.at("Emitter");
+            prefab.set<EmitterComponent>({
+                emitterJ.at("type").get<std::string>(),
+                emitterJ.at("amount").get<int>(),
+                emitterJ.value("active", false)
+            });
+        } else if (j.contains("EmitterPosition")) {
+            LOG_WARN(prefab.getName() << ": legacy emitter entry, write it as an \"Emitter\" object plus \"Position\"");
+            prefab.set<EmitterComponent>({
+                j.at("type").get<std::string>(),
+                j.at("amount").get<int>(),
+                j.value("active", false)
+            });
+            prefab.set<Position>({
+                j.at("EmitterPosition").at("x").get<float>(),
+                j.at("EmitterPosition").at("y").get<float>()
+            });
+        }
+
+        if (j.value("player", false)) {
+            prefab.set<PlayerComponent>({});
+            prefab.set<WallClingComponent>({});
+        }
+
+        if (j.contains("anim")) {
+            auto &animJ = j.at("anim");
+            std::string startAnim = animJ.at("start").get<std::string>();
+            int frameW = animJ.at("frameWidth").get<int>();
+            int frameH = animJ.at("frameHeight").get<int>();
+
+            AnimationComponent anim;
+            anim.currentState = startAnim;
+            TextureRegion startSheet;
+            for (auto it = j.at("spritePath").begin(); it != j.at("spritePath").end(); ++it) {
+                auto &stateJ = it.value();
+                if (!textures) continue; // Headless, the entity gets no frames
+
+                TextureRegion sheet = textures->load(stateJ.at("filePath").get<std::string>());
+                if (!sheet) {
+                    LOG_ERROR("Failed to load: " << stateJ.at("filePath"));
+                    continue;
+                }
+
+                anim.animations[it.key()] = {
+                    .texture    = sheet.texture,
+                    .region     = sheet.rect,
+                    .frameCount = stateJ.at("frameCount").get<int>(),
+                    .frameWidth = frameW,
+                    .frameHeight= frameH,
+                    .frameTime  = stateJ.at("frameTime").get<float>()
+                };
+
+                if (it.key() == startAnim)
+                    startSheet = sheet;
+            }
+            prefab.set<AnimationComponent>(std::move(anim));
+
+            if (startSheet) {
+                sf::Sprite sprite;
+                sprite.setTexture(*startSheet.texture);
+                sprite.setScale(3, 3);
+                sprite.setTextureRect(sf::IntRect(startSheet.rect.left, startSheet.rect.top, frameW, frameH));
+                sprite.setOrigin(frameW / 2.f, frameH / 2.f);
+                prefab.set<SpriteComponent>({sprite});
+            }
+        }
+
+        if (j.contains("actor")) {
+            prefab.set<ActorComponent>({j.at("actor").at("name").get<std::string>()});
+        }
+        if (j.contains("Position")) {
+            prefab.set<Position>({j.at("Position").at("x").get<float>(), j.at("Position").at("y").get<float>()});
+        }
+        if (j.contains("Velocity")) {
+            prefab.set<Velocity>({j.at("Velocity").at("dx").get<float>(), j.at("Velocity").at("dy").get<float>()});
+        }
+        if (j.contains("KnockBack")) {
+            if (j.at("KnockBack").get<bool>()) prefab.set<KnockBackComponent>({});
+        } else if (j.contains("Velocity")) {
+            // Entries written before the flag existed got knock-back with their Velocity
+            LOG_WARN(prefab.getName() << ": no \"KnockBack\" flag, added with the Velocity as before; set it explicitly");
+            prefab.set<KnockBackComponent>({});
+        }
+        if (j.value("Direction", false)) {
+            prefab.set<DirectionComponent>({});
+        }
+        if (j.contains("Collision")) {
+            ColliderComponent collider;
+            collider.bounds = rect(j.at("Collision"));
+            collider.isStatic = j.at("Collision").at("isStatic").get<bool>();
+            prefab.set<ColliderComponent>(collider);
+        }
+        if (j.contains("AttackCollisionRight")) {
+            AttackColliderComponent attack;
+            attack.boundsRight = rect(j.at("AttackCollisionRight"));
+            attack.boundsLeft = rect(j.at("AttackCollisionLeft"));
+            prefab.set<AttackColliderComponent>(attack);
+        }
+        if (j.contains("Projectile")) {
+            prefab.set<ProjectileComponent>({
+                j.at("Projectile").at("lifeTime").get<float>(),
+                j.at("Projectile").at("type").get<std::string>()
+            });
+        }
+
+        if (j.value("health", false)) {
+            prefab.set<HealthComponent>({});
+        }
+
+        if (j.value("ai-sys", false)) {
+            prefab.set<ActorComponent>({"NPC1"});
+            prefab.set<SeekComponent>({});
+            prefab.set<AIComponent>({});
+        }
+    }
+};
+
+#endif
@@ -2,12 +2,23 @@
 #define SYSTEM_H
 
 #include <cmath>
-#include <set>
 #include <cstdint>
+#include <SFML/System/Vector2.hpp>
+
+#include "Engine/Core/ComponentType.h"
+#include "Engine/Core/EntitySet.h"
+#include "Engine/Core/ResourceType.h"
 
 /**
  *@brief Represents a system that runs logic on entities.
  *       Wherein a derived system defines its own componet filter and behavior.
+ *       The filter is declared in the derived constructor with requireComponents<...>()
+ *       (and optionally excludeComponents<...>()), the SystemManager then keeps
+ *       'entities' in sync as components are added and removed.
+ *       A system that requires nothing has its entities managed by hand.
+ *       Separately, a system declares which component types and resources its update()
+ *       reads and writes (readsComponents<...>(), writesComponents<...>(), ...) so the
+ *       SystemScheduler can run systems that do not conflict at the same time.
  */
 
 struct UpdateContext;
@@ -16,11 +27,73 @@ using Entity = std::uint32_t;
 
 class System {
 public:
-    std::set<Entity> entities;
+    EntitySet entities;
+
+    Signature signature; // Components an entity must own to be a member.
+    Signature excluded; // Components an entity must NOT own to be a member.
+
+    Signature reads; // Component types update() only reads.
+    Signature writes; // Component types update() modifies.
+    ResourceSet resourceReads;
+    ResourceSet resourceWrites;
+    bool exclusive = false; // Can't share a frame slot, e.g. needs the main thread.
 
     virtual void update(const UpdateContext& ctxt) = 0;
     virtual ~System() = default;
 
+    template<typename... Components>
+    void requireComponents() {
+        (signature.set(componentType<Components>()), ...);
+    }
+
+    template<typename... Components>
+    void excludeComponents() {
+        (excluded.set(componentType<Components>()), ...);
+    }
+
+    template<typename... Components>
+    void readsComponents() {
+        (reads.set(componentType<Components>()), ...);
+    }
+
+    template<typename... Components>
+    void writesComponents() {
+        (writes.set(componentType<Components>()), ...);
+    }
+
+    template<typename... Resources>
+    void readsResources() {
+        (resourceReads.set(resourceType<Resources>()), ...);
+    }
+
+    template<typename... Resources>
+    void writesResources() {
+        (resourceWrites.set(resourceType<Resources>()), ...);
+    }
+
+    // For a system that never runs alongside another one. Structural changes don't need this,
+    // they are recorded into UpdateContext::commands and applied after all systems ran.
+    void runsExclusively() {
+        exclusive = true;
+    }
+
+    // True when the two systems may not run at the same time.
+    bool conflictsWith(const System& other) const {
+        if (exclusive || other.exclusive) return true;
+        return (writes & (other.reads | other.writes)).any() || (other.writes & reads).any() ||
+               (resourceWrites & (other.resourceReads | other.resourceWrites)).any() ||
+               (other.resourceWrites & resourceReads).any();
+    }
+
+    // True when the system manages its membership from signatures.
+    bool usesSignature() const {
+        return signature.any();
+    }
+
+    bool matches(const Signature& entitySignature) const {
+        return (entitySignature & signature) == signature && (entitySignature & excluded).none();
+    }
+
     // Helper function
 
 
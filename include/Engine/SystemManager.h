@@ -6,10 +6,13 @@
 #include <unordered_map>
 #include <typeindex>
 #include <cassert>
+#include <vector>
 
 /**
  *@brief Responsible for registering and retrieving systems.
  *       Every system operates on a filtered set of entities.
+ *       Systems must be registered before entities receive their components
+ *       in order to pick them up automatically.
  */
 class SystemManager {
 public:
@@ -31,12 +34,40 @@ public:
         return std::static_pointer_cast<T>(systems[typeID]);
     }
 
+    // Adds or removes the entity from every signature-driven system after its components changed.
+    void entitySignatureChanged(Entity entity, const Signature& entitySignature) {
+        for (auto& [_, system] : systems) {
+            if (!system->usesSignature()) continue;
+
+            if (system->matches(entitySignature)) {
+                system->entities.insert(entity);
+            } else {
+                system->entities.erase(entity);
+            }
+        }
+    }
+
+    // Sorts every system's entity list by ID, e.g. once a level has finished loading.
+    void sortEntities() {
+        for (auto& [_, system] : systems) {
+            system->entities.sort();
+        }
+    }
+
     // Function responsible for erasing an entity from all registered systems.
     void entityDestroyed(Entity entity) {
         for (auto& [_, system] : systems) {
             system->entities.erase(entity);
         }
     }
+
+    void entitiesDestroyed(const std::vector<Entity>& entities) {
+        for (auto& [_, system] : systems) {
+            for (Entity entity : entities) {
+                system->entities.erase(entity);
+            }
+        }
+    }
 private:
     std::unordered_map<std::type_index, std::shared_ptr<System> > systems;
 };
@@ -0,0 +1,203 @@
+#ifndef SYSTEMSCHEDULER_H
+#define SYSTEMSCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include "Engine/System.h"
+#include "Engine/Core/JobPool.h"
+#include "Engine/Core/Profiler.h"
+#include "Engine/Core/UpdateContext.h"
+
+/**
+ * @brief Runs a list of systems once per frame as a task graph.
+ *        Systems are added in their logical update order. Two systems that conflict (one writes a
+ *        component type or resource the other reads or writes) keep that order, systems that
+ *        don't conflict run at the same time on the context's JobPool.
+ *        Exclusive systems split the frame into stages and run alone on the calling thread.
+ *        With a profiler in the context every system update is timed as a section named after its class.
+ *        NOTE: component pools must exist before run(), see ComponentManager::registerComponents().
+ */
+class SystemScheduler {
+public:
+    void add(std::shared_ptr<System> system) {
+        systems.push_back(std::move(system));
+        sections.push_back(NO_SECTION);
+        built = false;
+        sectionsComplete = false;
+    }
+
+    /**
+     * @brief Groups the systems into stages and links every system to the earlier ones it conflicts with.
+     *        Called by run() after systems were added, or up front to inspect the graph.
+     */
+    void build() {
+        stages.clear();
+        for (std::size_t s = 0; s < systems.size(); ++s) {
+            const auto &system = systems[s];
+            if (system->exclusive) {
+                stages.push_back({true, {{system.get(), {}, 0, sections[s]}}});
+                continue;
+            }
+            if (stages.empty() || stages.back().exclusive) {
+                stages.push_back({false, {}});
+            }
+
+            std::vector<Node> &nodes = stages.back().nodes;
+            Node node{system.get(), {}, 0, sections[s]};
+            for (std::size_t i = 0; i < nodes.size(); ++i) {
+                if (nodes[i].system->conflictsWith(*system)) {
+                    nodes[i].dependents.push_back(nodes.size());
+                    ++node.dependencyCount;
+                }
+            }
+            nodes.push_back(std::move(node));
+        }
+
+        std::size_t largest = 0;
+        for (const Stage &stage: stages) {
+            largest = std::max(largest, stage.nodes.size());
+        }
+        remaining = std::make_unique<std::atomic<std::size_t>[]>(largest);
+        built = true;
+    }
+
+    // Updates every system once. Without a JobPool the systems simply run in order.
+    void run(const UpdateContext &ctxt) {
+        if (!built) build();
+        if (ctxt.profiler && (ctxt.profiler != sectionsOwner || !sectionsComplete)) addSections(*ctxt.profiler);
+
+        for (const Stage &stage: stages) {
+            if (stage.exclusive || !ctxt.jobs || stage.nodes.size() == 1) {
+                for (const Node &node: stage.nodes) {
+                    update(node, ctxt);
+                }
+                continue;
+            }
+            runStage(stage, ctxt);
+        }
+    }
+
+    std::size_t getStageCount() const { return stages.size(); }
+
+    // Readable class name of a system, e.g. "CollisionSystem".
+    static std::string nameOf(const System &system) {
+        const char *name = typeid(system).name();
+#if defined(__GNUG__)
+        int status = 0;
+        std::unique_ptr<char, void (*)(void *)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status),
+                                                         std::free);
+        if (status == 0) return demangled.get();
+#endif
+        std::string result = name;
+        for (const char *prefix: {"class ", "struct "}) {
+            if (result.rfind(prefix, 0) == 0) result.erase(0, std::char_traits<char>::length(prefix));
+        }
+        return result;
+    }
+
+private:
+    struct Node {
+        System *system;
+        std::vector<std::size_t> dependents; // Later nodes of the same stage waiting on this one
+        std::size_t dependencyCount;
+        std::size_t section; // Profiler section of this system
+    };
+
+    struct Stage {
+        bool exclusive;
+        std::vector<Node> nodes;
+    };
+
+    static constexpr std::size_t NO_SECTION = static_cast<std::size_t>(-1);
+
+    std::vector<std::shared_ptr<System> > systems;
+    std::vector<std::size_t> sections; // Profiler section of each entry of 'systems', NO_SECTION until added
+    std::vector<Stage> stages;
+    bool built = false;
+    Profiler *sectionsOwner = nullptr; // Profiler the sections were added to
+    bool sectionsComplete = false; // Every system has a section in sectionsOwner
+
+    // Per node, dependencies that have not finished yet this frame.
+    std::unique_ptr<std::atomic<std::size_t>[]> remaining;
+    std::atomic<std::size_t> unfinished{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    // Gives every system without one a section, systems that already have one keep it.
+    // A different profiler gets all systems added again.
+    void addSections(Profiler &profiler) {
+        if (&profiler != sectionsOwner) {
+            std::fill(sections.begin(), sections.end(), NO_SECTION);
+            sectionsOwner = &profiler;
+        }
+
+        std::size_t s = 0;
+        for (Stage &stage: stages) {
+            for (Node &node: stage.nodes) {
+                if (sections[s] == NO_SECTION) sections[s] = profiler.addSection(nameOf(*node.system));
+                node.section = sections[s++];
+            }
+        }
+        sectionsComplete = true;
+    }
+
+    static void update(const Node &node, const UpdateContext &ctxt) {
+        ProfileScope scope(ctxt.profiler, node.section, node.system->entities.size());
+        node.system->update(ctxt);
+    }
+
+    void runStage(const Stage &stage, const UpdateContext &ctxt) {
+        for (std::size_t i = 0; i < stage.nodes.size(); ++i) {
+            remaining[i].store(stage.nodes[i].dependencyCount);
+        }
+        unfinished.store(stage.nodes.size());
+
+        for (std::size_t i = 0; i < stage.nodes.size(); ++i) {
+            if (stage.nodes[i].dependencyCount == 0) {
+                schedule(stage, i, ctxt);
+            }
+        }
+
+        // Help with queued work while the stage is running.
+        while (unfinished.load() > 0) {
+            if (ctxt.jobs->runPending()) continue;
+
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait_for(lock, std::chrono::microseconds(200), [this] { return unfinished.load() == 0; });
+        }
+    }
+
+    void schedule(const Stage &stage, std::size_t index, const UpdateContext &ctxt) {
+        ctxt.jobs->submit([this, &stage, index, &ctxt] {
+            const Node &node = stage.nodes[index];
+            update(node, ctxt);
+
+            for (std::size_t dependent: node.dependents) {
+                if (remaining[dependent].fetch_sub(1) == 1) {
+                    schedule(stage, dependent, ctxt);
+                }
+            }
+
+            if (unfinished.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        });
+    }
+};
+
+#endif
@@ -9,32 +9,29 @@
 #include "Engine/Components/PlayerComponent.h"
 #include "Engine/Components/Position.h"
 #include "Engine/Components/Velocity.h"
+#include "Engine/Components/DirectionComponent.h"
 #include <cmath>
 
 class AISystem : public System {
 public:
+    AISystem() {
+        requireComponents<AIComponent, Position, Velocity, DirectionComponent>();
+        readsComponents<AIComponent, PlayerComponent, Position>();
+        writesComponents<Velocity, DirectionComponent>();
+    }
+
     void update(const UpdateContext& ctxt) override {
         auto& components = *ctxt.component;
         auto& dt = ctxt.dt;
 
         sf::Vector2f playerPos{0,0};
-        for (Entity entity : entities)
+        if (components.track<PlayerComponent, Position>(player, *ctxt.entity))
         {
-            if (components.hasComponent<PlayerComponent>(entity))
-            {
-                auto& p = components.getComponent<Position>(entity);
-                playerPos = {p.x, p.y};
-                break;
-            }
+            auto& p = components.getComponent<Position>(player.index);
+            playerPos = {p.x, p.y};
         }
 
-        for (Entity entity : entities) {
-            if (!components.hasComponent<AIComponent>(entity)) continue;
-
-            auto& aiComp = components.getComponent<AIComponent>(entity);
-            auto& pos = components.getComponent<Position>(entity);
-            auto& vel = components.getComponent<Velocity>(entity);
-            auto& dirCom = components.getComponent<DirectionComponent>(entity);
+        for (auto [entity, aiComp, pos, vel, dirCom] : components.view<AIComponent, Position, Velocity, DirectionComponent>(entities)) {
 
             if (aiComp.state == AIState::Idle)
             {
@@ -61,7 +58,7 @@ public:
         }
     }
 private:
-    sf::Vector2f targetPos;
+    EntityHandle player; // Kept across frames, only searched for again once it is gone
 };
 
 #endif
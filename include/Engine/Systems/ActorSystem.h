@@ -6,9 +6,22 @@
 #include "Engine/ComponentManager.h"
 #include "Engine/EntityManager.h"
 #include "Engine/Components/ActorComponent.h"
+#include "Engine/Components/AIComponent.h"
+#include "Engine/Components/AnimationComponent.h"
+#include "Engine/Components/DirectionComponent.h"
+#include "Engine/Components/Position.h"
+#include "Engine/Components/Velocity.h"
 
 class ActorSystem : public System {
 public:
+    // AI driven actors are steered by the AISystem instead.
+    ActorSystem() {
+        requireComponents<ActorComponent, DirectionComponent, AnimationComponent, Velocity, Position>();
+        excludeComponents<AIComponent>();
+        readsComponents<ActorComponent, Position>();
+        writesComponents<DirectionComponent, AnimationComponent, Velocity>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &component = *ctxt.component;
         float dt = ctxt.dt;
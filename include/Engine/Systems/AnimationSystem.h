@@ -3,77 +3,79 @@
 
 #include "Engine/System.h"
 #include "Engine/Core/UpdateContext.h"
+#include "Engine/Core/Log.h"
 #include "Engine/ComponentManager.h"
 #include "Engine/Components/AnimationComponent.h"
 #include "Engine/Components/SpriteComponent.h"
-#include <iostream>
 
 class AnimationSystem : public System {
 public:
+    AnimationSystem() {
+        requireComponents<AnimationComponent, SpriteComponent>();
+        readsComponents<KnockBackComponent, PlayerComponent, WallClingComponent, DirectionComponent>();
+        writesComponents<AnimationComponent, SpriteComponent>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
         float dt = ctxt.dt;
-        for (Entity entity: entities) {
-            if (components.hasComponent<AnimationComponent>(entity) && components.hasComponent<
-                    SpriteComponent>(entity)) {
-                auto &animComp = components.getComponent<AnimationComponent>(entity);
-                auto &sprite = components.getComponent<SpriteComponent>(entity).sprite;
+        for (auto [entity, animComp, spriteComp]: components.view<AnimationComponent, SpriteComponent>(entities)) {
+            auto &sprite = spriteComp.sprite;
 
-                if (components.hasComponent<KnockBackComponent>(entity) && !components.hasComponent<
-                        PlayerComponent>(entity)) {
-                    auto &knock = components.getComponent<KnockBackComponent>(entity);
-                    if (knock.isKnockback) {
-                        animComp.currentState = "hurt";
-                    }
+            if (components.hasComponent<KnockBackComponent>(entity) && !components.hasComponent<
+                    PlayerComponent>(entity)) {
+                auto &knock = components.getComponent<KnockBackComponent>(entity);
+                if (knock.isKnockback) {
+                    animComp.currentState = "hurt";
                 }
+            }
 
-                // Grab wall cling anim first.
-                if (components.hasComponent<WallClingComponent>(entity)) {
-                    auto &cling = components.getComponent<WallClingComponent>(entity);
-                    auto &dir = components.getComponent<DirectionComponent>(entity);
-                    if (cling.active) {
-                        if (animComp.currentState == "jumpLeft") {
-                            animComp.currentState = "wallLeft";
-                        } else if (animComp.currentState == "jumpRight") {
-                            animComp.currentState = "wallRight";
-                        }
+            // Grab wall cling anim first.
+            if (components.hasComponent<WallClingComponent>(entity)) {
+                auto &cling = components.getComponent<WallClingComponent>(entity);
+                auto &dir = components.getComponent<DirectionComponent>(entity);
+                if (cling.active) {
+                    if (animComp.currentState == "jumpLeft") {
+                        animComp.currentState = "wallLeft";
+                    } else if (animComp.currentState == "jumpRight") {
+                        animComp.currentState = "wallRight";
                     }
                 }
+            }
 
-                // Get the current state's animation data
-                auto it = animComp.animations.find(animComp.currentState);
-                if (it == animComp.animations.end()) {
-                    std::cerr << "Missing animation state: " << animComp.currentState << "\n";
-                    continue;
-                }
-
-                AnimationData &animData = it->second;
-
-                // If state changed, reset frame and update texture
-                if (animComp.currentState != animComp.previousState) {
-                    animComp.previousState = animComp.currentState;
-                    animComp.currentFrame = 0;
-                    animComp.elapsedTime = 0.0f;
+            // Get the current state's animation data
+            auto it = animComp.animations.find(animComp.currentState);
+            if (it == animComp.animations.end()) {
+                LOG_WARN("Missing animation state: " << animComp.currentState);
+                continue;
+            }
 
-                    sprite.setTexture(*animData.texture);
-                }
+            AnimationData &animData = it->second;
 
-                // Advance animation based on time
-                animComp.elapsedTime += dt;
-                if (animComp.elapsedTime >= animData.frameTime) {
-                    animComp.elapsedTime = 0.0f;
-                    animComp.currentFrame = (animComp.currentFrame + 1) % animData.frameCount;
-                }
+            // If state changed, reset frame and update texture
+            if (animComp.currentState != animComp.previousState) {
+                animComp.previousState = animComp.currentState;
+                animComp.currentFrame = 0;
+                animComp.elapsedTime = 0.0f;
 
                 sprite.setTexture(*animData.texture);
-                // Update the sprite's texture rectangle
-                sprite.setTextureRect(sf::IntRect(
-                    animComp.currentFrame * animData.frameWidth,
-                    0, // Assumes single-row sprite sheets
-                    animData.frameWidth,
-                    animData.frameHeight
-                ));
             }
+
+            // Advance animation based on time
+            animComp.elapsedTime += dt;
+            if (animComp.elapsedTime >= animData.frameTime) {
+                animComp.elapsedTime = 0.0f;
+                animComp.currentFrame = (animComp.currentFrame + 1) % animData.frameCount;
+            }
+
+            sprite.setTexture(*animData.texture);
+            // Update the sprite's texture rectangle
+            sprite.setTextureRect(sf::IntRect(
+                animData.region.left + animComp.currentFrame * animData.frameWidth,
+                animData.region.top, // Assumes single-row sprite sheets
+                animData.frameWidth,
+                animData.frameHeight
+            ));
         }
     }
 };
@@ -4,6 +4,7 @@
 #include "Engine/System.h"
 #include "Engine/Core/UpdateContext.h"
 #include "Engine/Components/Position.h"
+#include "Engine/Components/PlayerComponent.h"
 #include <SFML/Graphics/View.hpp>
 
 #include "Engine/ComponentManager.h"
@@ -11,8 +12,12 @@
 class CameraSystem : public System {
 public:
     sf::View view;
+    sf::Vector2f previousCenter; // View center before the last simulation step
 
     CameraSystem(float width, float height) {
+        requireComponents<PlayerComponent, Position>();
+        readsComponents<Position>();
+        writesResources<CameraSystem>(); // 'view', read by the engine once the frame's systems ran
         view.setSize(width, height);
         view.setCenter(0.f, 0.f);
     }
@@ -20,34 +25,40 @@ public:
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
         float dt = ctxt.dt;
+        previousCenter = view.getCenter();
         for (Entity entity: entities) {
-            if (!components.hasComponent<Position>(entity)) continue;
-            if (components.hasComponent<PlayerComponent>(entity)) {
-                auto &pos = components.getComponent<Position>(entity);
+            auto &pos = components.getComponent<Position>(entity);
 
-                float targetX = pos.x;
-                float targetY = pos.y;
+            float targetX = pos.x;
+            float targetY = pos.y;
 
-                float halfWidth = view.getSize().x / 2.f;
-                float halfHeight = view.getSize().y / 2.f;
+            float halfWidth = view.getSize().x / 2.f;
+            float halfHeight = view.getSize().y / 2.f;
 
-                // Level bounds (example: 2000x2000 pixels)
-                float levelWidth = 2000.f;
-                float levelHeight = 2000.f;
+            // Level bounds (example: 2000x2000 pixels)
+            float levelWidth = 2000.f;
+            float levelHeight = 2000.f;
 
-                // Clamp X
-                if (targetX < halfWidth) targetX = halfWidth;
-                if (targetX > levelWidth - halfWidth) targetX = levelWidth - halfWidth;
+            // Clamp X
+            if (targetX < halfWidth) targetX = halfWidth;
+            if (targetX > levelWidth - halfWidth) targetX = levelWidth - halfWidth;
 
-                // Clamp Y
-                if (targetY < halfHeight) targetY = halfHeight;
-                if (targetY > levelHeight - halfHeight) targetY = levelHeight - halfHeight;
+            // Clamp Y
+            if (targetY < halfHeight) targetY = halfHeight;
+            if (targetY > levelHeight - halfHeight) targetY = levelHeight - halfHeight;
 
-                view.setCenter(targetX, targetY);
-                break; // Only first entity should be tracked (player)
-            }
+            view.setCenter(targetX, targetY);
+            break; // Only first entity should be tracked (player)
         }
     }
+
+    // The view between the last two simulation steps, alpha as in UpdateContext.
+    sf::View interpolatedView(float alpha) const {
+        sf::View blended = view;
+        const sf::Vector2f &center = view.getCenter();
+        blended.setCenter(previousCenter + (center - previousCenter) * alpha);
+        return blended;
+    }
 };
 
 #endif
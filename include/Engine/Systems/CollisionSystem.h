@@ -4,6 +4,7 @@
 
 #include "Engine/System.h"
 #include "Engine/Core/UpdateContext.h"
+#include "Engine/Core/Log.h"
 #include "Engine/ComponentManager.h"
 #include "Engine/Components/ActorComponent.h"
 #include "Engine/Components/ColliderComponent.h"
@@ -11,16 +12,20 @@
 #include "Engine/Components/HealthComponent.h"
 #include "Engine/Components/KnockBackComponent.h"
 #include "Engine/Components/Position.h"
+#include "Engine/Components/Velocity.h"
 #include "Engine/Components/PlayerComponent.h"
 #include "Engine/Components/TileComponent.h"
 #include "Engine/Components/WallClingComponent.h"
 #include "Engine/Components/AIComponent.h"
+#include "Engine/Core/SpatialHash.h"
+#include "Engine/Core/SolidityGrid.h"
+#include "Engine/Systems/PhysicsSystem.h"
 
 
 // TESTING OUT COMMENTING AND DOCUMENTATION STYLE
 
 struct Contact {
-    Entity other;
+    EntityHandle other;
     glm::vec2 point;
     glm::vec2 normal;
     float penetration{};
@@ -31,27 +36,31 @@ struct Contact {
  */
 class CollisionSystem : public System {
 public:
-    bool isSolidAt(ComponentManager &component, float x, float y) const {
-        for (Entity e: entities) {
-            if (component.hasComponent<TileComponent>(e)
-                && component.hasComponent<ColliderComponent>(e)
-                && component.hasComponent<Position>(e)) {
-                auto &col = component.getComponent<ColliderComponent>(e);
-                auto &pos = component.getComponent<Position>(e);
-
-                sf::FloatRect bounds{
-                    pos.x + col.bounds.left,
-                    pos.y + col.bounds.top,
-                    col.bounds.width,
-                    col.bounds.height
-                };
+    // Default broad-phase cell size: one 16px tile at the map's 3x scale.
+    static constexpr float DEFAULT_CELL_SIZE = 16.f * 3.f;
+    // A dynamic body resting on a tile for SLEEP_STEPS steps, moving less than SLEEP_EPSILON pixels, falls asleep.
+    static constexpr int SLEEP_STEPS = 30;
+    static constexpr float SLEEP_EPSILON = 0.5f;
+
+    CollisionSystem() {
+        requireComponents<ColliderComponent, Position>();
+        readsComponents<TileComponent, AttackColliderComponent>();
+        writesComponents<ColliderComponent, Position, Velocity, PlayerComponent, WallClingComponent, HealthComponent,
+            KnockBackComponent, AIComponent, ActorComponent>();
+    }
 
-                if (bounds.contains(x, y)) {
-                    return true;
-                }
-            }
-        }
-        return false;
+    void setCellSize(float size) {
+        staticPhase.setCellSize(size);
+        dynamicPhase.setCellSize(size);
+        staticBodies.clear(); // Forces the static colliders to be re-bucketed
+    }
+
+    // Solidity of the static tile map, baked by TileMapSystem::loadMap.
+    void setSolidityGrid(SolidityGrid grid) { solidity = std::move(grid); }
+    const SolidityGrid &getSolidityGrid() const { return solidity; }
+
+    bool isSolidAt(float x, float y) const {
+        return solidity.isSolidAt(x, y);
     }
 
     static void handleWallContacts(Entity entity, ComponentManager &components, const Contact &contact) {
@@ -64,7 +73,7 @@ public:
             cling.active = true;
             cling.timer = 0.f;
             cling.wallNormal = contact.normal; //Points from the wall to player
-            std::cout << "Wall contact" << std::endl;
+            LOG_TRACE("Wall contact {" << entity << "}");
         }
     }
 
@@ -86,7 +95,7 @@ public:
             {
                 aiComp.state = AIState::Idle;
             }
-            std::cout << "Hit: " << actComp.name << std::endl;
+            LOG_DEBUG("Hit: " << actComp.name);
         }
     }
 
@@ -96,6 +105,7 @@ public:
         // clear the *touched* flag (not the active flag)
         //float dt =  ctxt.dt;
         ComponentManager& components = *ctxt.component;
+        const EntityManager& entityManager = *ctxt.entity;
         for (Entity e: entities)
         {
             if (components.hasComponent<WallClingComponent>(e))
@@ -103,10 +113,40 @@ public:
                 components.getComponent<WallClingComponent>(e).touchedThisFrame = false;
             }
         }
+
+        // Broad-phase: static colliders never move, so they are only re-bucketed when that set changes.
+        // Dynamic colliders are re-bucketed every frame, and again when the narrow phase moves them.
+        staticScratch.clear();
+        dynamicBodies.clear();
+        dynamicPhase.clear();
+        for (auto [e, col, pos]: components.view<ColliderComponent, Position>(entities))
+        {
+            if (col.isStatic)
+            {
+                staticScratch.push_back(e);
+            }
+            else
+            {
+                dynamicBodies.push_back(e);
+                dynamicPhase.insert(e, worldBounds(col, pos));
+            }
+        }
+        bool staticChanged = staticScratch != staticBodies; // A support may be gone, sleeping bodies wake up
+        if (staticChanged)
+        {
+            staticBodies.swap(staticScratch);
+            staticPhase.clear();
+            for (Entity e: staticBodies)
+            {
+                staticPhase.insert(e, worldBounds(components.getComponent<ColliderComponent>(e),
+                                                  components.getComponent<Position>(e)));
+            }
+        }
+
         // Attack collision loop
         for (Entity entity: entities)
             {
-            if (components.hasComponent<PlayerComponent>(entity) && components.hasComponent<AttackColliderComponent>(entity) && components.hasComponent<Position>(entity))
+            if (components.hasComponent<PlayerComponent>(entity) && components.hasComponent<AttackColliderComponent>(entity))
                 {
                 auto &attCol = components.getComponent<AttackColliderComponent>(entity);
                 auto &attPos = components.getComponent<Position>(entity);
@@ -127,10 +167,11 @@ public:
                     attCol.boundsRight.height
                 };
 
-                for (Entity other: entities)
+                query(merge(attBoundsRight, attBoundsLeft));
+                for (Entity other: candidates)
                     {
                     if (other == entity) continue;
-                    if (!components.hasComponent<ColliderComponent>(other) || !components.hasComponent<HealthComponent>(other))
+                    if (!components.hasComponent<HealthComponent>(other))
                     {
                         continue;
                     }
@@ -153,7 +194,7 @@ public:
                         hit = attBoundsRight.intersects(otherBounds, attackIntersection);
                         if (hit)
                         {
-                            std::cout << components.getComponent<HealthComponent>(other).health << std::endl;
+                            LOG_DEBUG("Attack hit {" << other << "}, health " << components.getComponent<HealthComponent>(other).health);
                         }
                     }
                     if (!hit && attCol.activeLeft)
@@ -166,7 +207,7 @@ public:
 
                     if (overlapX < overlapY && attCol.activeRight)
                     {
-                        std::cout << "Hit Right" << std::endl;
+                        LOG_DEBUG("Hit right");
                         if (components.hasComponent<PlayerComponent>(entity))
                         {
                             auto& player = components.getComponent<PlayerComponent>(entity);
@@ -200,7 +241,7 @@ public:
                     }
                 }
             }
-            if (!components.hasComponent<PlayerComponent>(entity) && components.hasComponent<AttackColliderComponent>(entity) && components.hasComponent<Position>(entity))
+            if (!components.hasComponent<PlayerComponent>(entity) && components.hasComponent<AttackColliderComponent>(entity))
             {
                 auto &attCol = components.getComponent<AttackColliderComponent>(entity);
                 auto &attPos = components.getComponent<Position>(entity);
@@ -220,10 +261,11 @@ public:
                     attCol.boundsLeft.width,
                     attCol.boundsRight.height
                 };
-                for (Entity other: entities)
+                query(merge(attBoundsRight, attBoundsLeft));
+                for (Entity other: candidates)
                 {
                     if (other == entity) continue;
-                    if (!components.hasComponent<ColliderComponent>(other) || !components.hasComponent<HealthComponent>(other))
+                    if (!components.hasComponent<HealthComponent>(other))
                     {
                         continue;
                     }
@@ -246,7 +288,7 @@ public:
                         hit = attBoundsRight.intersects(otherBounds, attackIntersection);
                         if (hit)
                         {
-                            std::cout << components.getComponent<HealthComponent>(other).health << std::endl;
+                            LOG_DEBUG("Attack hit {" << other << "}, health " << components.getComponent<HealthComponent>(other).health);
                         }
                     }
                     if (!hit && attCol.activeLeft)
@@ -260,14 +302,14 @@ public:
                     {
                         if (components.hasComponent<PlayerComponent>(other))
                         {
-                            std::cout << "HIT ON PLAYER" << std::endl;
+                            LOG_DEBUG("Hit on player");
                         }
                     }
                     else if (overlapX < overlapY && attCol.activeLeft)
                     {
                         if (components.hasComponent<PlayerComponent>(other))
                         {
-                            std::cout << "HIT ON PLAYER" << std::endl;
+                            LOG_DEBUG("Hit on player");
                             auto&pos = components.getComponent<Position>(entity);
                             auto& knockOther = components.getComponent<KnockBackComponent>(other);
                             sf::Vector2f direction = normalize(sf::Vector2f{otherPos.x, otherPos.y} - sf::Vector2f{pos.x, pos.y}); //Make direction = (pos - otherPos) for a pull effect
@@ -280,17 +322,33 @@ public:
             }
         }
 
-        // Double loop: broad-phase & narrow-phase collision tests (might change)
-        for (Entity a: entities)
+        // Narrow-phase collision tests against the broad-phase candidates.
+        // Only dynamic bodies are tested, static-vs-static pairs can never change.
+        for (Entity a: dynamicBodies)
         {
-            if (!components.hasComponent<ColliderComponent>(a) || !components.hasComponent<Position>(a))
-            {
-                continue;
-            }
-
             auto &aCol = components.getComponent<ColliderComponent>(a);
             auto &aPos = components.getComponent<Position>(a);
 
+            if (aCol.sleeping)
+            {
+                if (!staticChanged && !isDisturbed(components, a, aCol, aPos, ctxt.dt))
+                {
+                    // Only gravity has acted on it: put it back on its support, as resolving it would.
+                    sf::FloatRect moved = worldBounds(aCol, aPos);
+                    aPos.x = aCol.restPosition.x;
+                    aPos.y = aCol.restPosition.y;
+                    if (components.hasComponent<Velocity>(a))
+                        components.getComponent<Velocity>(a).dy = 0.f;
+                    if (components.hasComponent<PlayerComponent>(a))
+                        components.getComponent<PlayerComponent>(a).isGrounded = true;
+                    dynamicPhase.move(a, moved, worldBounds(aCol, aPos));
+                    continue;
+                }
+                wake(aCol);
+            }
+            bool moving = aCol.restSteps == 0; // Bodies settling next to each other don't keep waking each other
+            bool supported = false;
+
             sf::FloatRect aBounds
             {
                 aPos.x + aCol.bounds.left,
@@ -299,13 +357,10 @@ public:
                 aCol.bounds.height
             };
 
-            for (Entity b: entities)
+            query(aBounds);
+            for (Entity b: candidates)
             {
                 if (a == b) continue;
-                if (!components.hasComponent<ColliderComponent>(b) || !components.hasComponent<Position>(b))
-                {
-                    continue;
-                }
 
                 auto &bCol = components.getComponent<ColliderComponent>(b);
                 auto &bPos = components.getComponent<Position>(b);
@@ -323,6 +378,10 @@ public:
                 {
                     continue; // → no collision this pair
                 }
+                if (bCol.sleeping && moving)
+                {
+                    wake(bCol); // Woken by contact
+                }
 
                 // Build a contact normal so that “wall” vs “floor/ceiling” is discernible
                 float overlapX = intersection.width;
@@ -338,7 +397,7 @@ public:
                 if (components.hasComponent<WallClingComponent>(a))
                 {
                     Contact c;
-                    c.other = b;
+                    c.other = entityManager.getHandle(b);
                     c.normal = normal;
                     c.penetration = (overlapX < overlapY) ? overlapX : overlapY;
 
@@ -382,6 +441,7 @@ public:
                         if (normal.y < 0)
                         {
                             aPos.y -= overlapY;
+                            supported = true;
 
                             if (components.hasComponent<Velocity>(a))
                                 components.getComponent<Velocity>(a).dy = 0.f;
@@ -399,6 +459,19 @@ public:
                     }
                 }
             } // inner
+
+            // Later pairs and queries this frame must see the corrected position.
+            dynamicPhase.move(a, aBounds, worldBounds(aCol, aPos));
+
+            if (supported && isResting(components, a, aCol, aPos))
+            {
+                if (++aCol.restSteps >= SLEEP_STEPS) aCol.sleeping = true;
+            }
+            else
+            {
+                aCol.restSteps = 0;
+                aCol.restPosition = {aPos.x, aPos.y};
+            }
         } // outer
         //Post-pass – turn cling off if *never* touched a wall this frame
         for (Entity e: entities)
@@ -410,6 +483,61 @@ public:
     }
 
 private:
+    SpatialHash staticPhase{DEFAULT_CELL_SIZE};
+    SpatialHash dynamicPhase{DEFAULT_CELL_SIZE};
+    SolidityGrid solidity;
+    std::vector<Entity> staticBodies; // Static colliders bucketed in staticPhase
+    std::vector<Entity> dynamicBodies; // Non-static colliders this frame
+    std::vector<Entity> staticScratch;
+    std::vector<Entity> candidates; // Scratch buffers for broad-phase queries
+    std::vector<Entity> dynamicCandidates;
+
+    // Collects every collider near area into candidates, in entity order.
+    void query(const sf::FloatRect &area) {
+        staticPhase.query(area, candidates);
+        dynamicPhase.query(area, dynamicCandidates);
+        auto middle = candidates.insert(candidates.end(), dynamicCandidates.begin(), dynamicCandidates.end());
+        std::inplace_merge(candidates.begin(), middle, candidates.end());
+    }
+
+    // Whether a body pushed back onto its support has stayed where it came to rest, without moving sideways.
+    static bool isResting(ComponentManager &components, Entity entity, const ColliderComponent &col, const Position &pos) {
+        if (components.hasComponent<Velocity>(entity) && components.getComponent<Velocity>(entity).dx != 0.f) return false;
+        return std::abs(pos.x - col.restPosition.x) < SLEEP_EPSILON && std::abs(pos.y - col.restPosition.y) < SLEEP_EPSILON;
+    }
+
+    // Whether anything but gravity has moved a sleeping body, or changed its velocity, since it was last resolved.
+    static bool isDisturbed(ComponentManager &components, Entity entity, const ColliderComponent &col,
+                            const Position &pos, float dt) {
+        float fallen = 0.f;
+        if (components.hasComponent<Velocity>(entity))
+        {
+            auto &vel = components.getComponent<Velocity>(entity);
+            if (vel.dx != 0.f || vel.dy < 0.f || vel.dy > PhysicsSystem::GRAVITY * dt) return true;
+            fallen = vel.dy * dt; // Applied by the movement system
+        }
+        return std::abs(pos.x - col.restPosition.x) >= SLEEP_EPSILON ||
+               std::abs(pos.y - fallen - col.restPosition.y) >= SLEEP_EPSILON;
+    }
+
+    static void wake(ColliderComponent &col) {
+        col.sleeping = false;
+        col.restSteps = 0;
+    }
+
+    static sf::FloatRect worldBounds(const ColliderComponent &col, const Position &pos) {
+        return {pos.x + col.bounds.left, pos.y + col.bounds.top, col.bounds.width, col.bounds.height};
+    }
+
+    // Smallest rectangle containing both a and b.
+    static sf::FloatRect merge(const sf::FloatRect &a, const sf::FloatRect &b) {
+        float left = std::min(a.left, b.left);
+        float top = std::min(a.top, b.top);
+        float right = std::max(a.left + a.width, b.left + b.width);
+        float bottom = std::max(a.top + a.height, b.top + b.height);
+        return {left, top, right - left, bottom - top};
+    }
+
     //const DamageSystem* m_damageSystem = nullptr;
 };
 
@@ -1,26 +1,33 @@
 #ifndef DAMAGESYSTEM_H
 #define DAMAGESYSTEM_H
 
-#include <iostream>
 
 #include "ParticleSystem/ParticleSystemBase.h"
 #include "ParticleSystem/HomingParticleSystem.h"
 #include "Engine/ComponentManager.h"
 #include "Engine/System.h"
+#include "Engine/Core/CommandBuffer.h"
 #include "Engine/Core/UpdateContext.h"
+#include "Engine/Core/Log.h"
 #include "Engine/SystemManager.h"
 #include "Engine/Components/EmitterComponent.h"
 #include "Engine/Components/Position.h"
 #include "Engine/Components/HealthComponent.h"
 #include "ParticleSystem/FluidParticleSystem.h"
 #include "ParticleSystem/GaseousParticleSystem.h"
+#include "ParticleSystem/StaticFluidParticleSystem.h"
 
 class DamageSystem : public System {
 public:
+    DamageSystem() {
+        requireComponents<HealthComponent>();
+        readsComponents<PlayerComponent, Position>();
+        writesComponents<HealthComponent>();
+        writesResources<StaticFluidParticleSystem>(); // Death bursts
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
-        EntityManager &entityManager = *ctxt.entity;
-        SystemManager &systemManager = *ctxt.system;
         std::vector<sf::Drawable *> drawables = ctxt.drawables;
         auto &basePtrH = ctxt.particleSystems[0];
         auto &basePtrF = ctxt.particleSystems[1];
@@ -38,7 +45,7 @@ public:
                 auto &player = components.getComponent<PlayerComponent>(entity);
 
                 if (health.isLow) {
-                    std::cout << "LOW HEALTH\n";
+                    LOG_TRACE("Low health {" << entity << "}");
                 }
 
                 if (health.health < 80) {
@@ -46,7 +53,7 @@ public:
                 }
             }
             // Deleting entities upon 'Death'
-            if (components.hasComponent<HealthComponent>(entity) && !components.hasComponent<PlayerComponent>(entity)) {
+            if (!components.hasComponent<PlayerComponent>(entity)) {
                 auto &health = components.getComponent<HealthComponent>(entity);
                 if (health.health <= 0) {
                     health.isDead = true;
@@ -59,9 +66,8 @@ public:
                     sfps->setEmitter(burstPos);
                     sfps->spawnParticles(20);
 
-                    std::cout << "Entity Destroyed\n";
-                    entityManager.destroyEntity(entity);
-                    systemManager.entityDestroyed(entity);
+                    LOG_DEBUG("Entity destroyed {" << entity << "}");
+                    ctxt.commands->destroy(entity);
                 }
             }
         }
@@ -11,6 +11,12 @@
 
 class EmitterSystem : public System {
 public:
+    EmitterSystem() {
+        requireComponents<EmitterComponent, Position>();
+        readsComponents<EmitterComponent, Position>();
+        writesResources<GaseousParticleSystem, FluidParticleSystem>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager& components = *ctxt.component;
         float dt = ctxt.dt; // Might use to slow down particle spawn rate
@@ -23,20 +29,18 @@ public:
         auto gps = std::dynamic_pointer_cast<GaseousParticleSystem>(basePtrG);
 
         for (Entity entity : entities) {
-            if (components.hasComponent<EmitterComponent>(entity)) {
-                auto& emitter = components.getComponent<EmitterComponent>(entity);
-                auto& pos = components.getComponent<Position>(entity);
-
-                sf::Vector2f emitterPos = {pos.x, pos.y};
-
-                if (emitter.type == "gas") {
-                    gps->setEmitter(emitterPos);
-                    gps->spawnParticles(emitter.amount);
-                }
-                if (emitter.type == "fluid") {
-                    fps->setEmitter(emitterPos);
-                    fps->spawnParticles(emitter.amount);
-                }
+            auto& emitter = components.getComponent<EmitterComponent>(entity);
+            auto& pos = components.getComponent<Position>(entity);
+
+            sf::Vector2f emitterPos = {pos.x, pos.y};
+
+            if (emitter.type == "gas") {
+                gps->setEmitter(emitterPos);
+                gps->spawnParticles(emitter.amount);
+            }
+            if (emitter.type == "fluid") {
+                fps->setEmitter(emitterPos);
+                fps->spawnParticles(emitter.amount);
             }
         }
     }
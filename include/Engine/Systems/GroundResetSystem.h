@@ -7,13 +7,15 @@
 
 class GroundResetSystem : public System {
 public:
+    GroundResetSystem() {
+        requireComponents<PlayerComponent>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
         float dt = ctxt.dt;
         for (Entity entity: entities) {
-            if (components.hasComponent<PlayerComponent>(entity)) {
-                components.getComponent<PlayerComponent>(entity).isGrounded = false;
-            }
+            components.getComponent<PlayerComponent>(entity).isGrounded = false;
         }
     }
 };
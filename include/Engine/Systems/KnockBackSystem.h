@@ -11,18 +11,18 @@
 
 class KnockBackSystem : public System {
 public:
+    KnockBackSystem() {
+        requireComponents<KnockBackComponent, Position>();
+        writesComponents<KnockBackComponent, Position>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
         float dt = ctxt.dt;
 
-        for (Entity entity: entities) {
-            if (!components.hasComponent<KnockBackComponent>(entity)) continue;
-
-            auto &knock = components.getComponent<KnockBackComponent>(entity);
+        for (auto [entity, knock, pos]: components.view<KnockBackComponent, Position>(entities)) {
             if (!knock.isKnockback) continue;
 
-            auto &pos = components.getComponent<Position>(entity);
-
             pos.x += knock.velocity.x * dt;
             pos.y += knock.velocity.y * dt;
 
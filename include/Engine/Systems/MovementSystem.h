@@ -14,23 +14,29 @@
 #include "Engine/Components/AnimationComponent.h"
 #include "Engine/Components/DirectionComponent.h"
 #include "Engine/Components/PlayerComponent.h"
+#include "Engine/Components/ProjectileComponent.h"
 #include "Engine/Components/WallClingComponent.h"
 
 
 /**
  * System which moves entities by applying velocity to position at each frame.
  * Requires: Position, Velocity.
+ * Projectiles are moved by the ProjectileSystem instead.
  */
 class MovementSystem : public System {
 public:
+    MovementSystem() {
+        requireComponents<Position, Velocity>();
+        excludeComponents<ProjectileComponent>();
+        readsComponents<PlayerComponent>();
+        writesComponents<Position, Velocity, WallClingComponent>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
         float dt = ctxt.dt;
 
-        for (Entity entity: entities) {
-            if (!components.hasComponent<Position>(entity) || !components.hasComponent<Velocity>(entity)) continue;
-            auto &pos = components.getComponent<Position>(entity);
-            auto &vel = components.getComponent<Velocity>(entity);
+        for (auto [entity, pos, vel]: components.view<Position, Velocity>(entities)) {
 
             //std::cout << "{" << pos.x << ", " << pos.y << "}" << std::endl;
 
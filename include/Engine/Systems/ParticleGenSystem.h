@@ -5,7 +5,6 @@
 #ifndef PARTICLEGENSYSTEM_H
 #define PARTICLEGENSYSTEM_H
 
-#include <iostream>
 
 #include "ParticleSystem/ParticleSystemBase.h"
 #include "ParticleSystem/HomingParticleSystem.h"
@@ -13,6 +12,7 @@
 #include "Engine/EntityManager.h"
 #include "Engine/System.h"
 #include "Engine/Core/UpdateContext.h"
+#include "Engine/Core/Log.h"
 #include "Engine/SystemManager.h"
 #include "Engine/Components/EmitterComponent.h"
 #include "Engine/Components/Position.h"
@@ -23,6 +23,12 @@
 class ParticleGenSystem : public System
 {
 public:
+    ParticleGenSystem()
+    {
+        readsComponents<PlayerComponent, HealthComponent, Position>();
+        writesResources<GaseousParticleSystem>();
+    }
+
     void update(const UpdateContext &ctxt) override
     {
         ComponentManager &components = *ctxt.component;
@@ -47,7 +53,7 @@ public:
 
                     gps->setEmitter(burstPos);
                     gps->spawnParticles(5);
-                    std::cout << "Smoking" << std::endl;
+                    LOG_TRACE("Smoking {" << entity << "}");
                 }
             }
 
@@ -18,12 +18,16 @@ public:
     sf::Vector2f m_lastPlayerPos{0.f, 0.f};
     bool m_firstFrame{true};
 
+    FluidParticleSystem()
+    {
+        readsComponents<PlayerComponent, Position, ColliderComponent, Velocity>();
+        writesResources<FluidParticleSystem>();
+    }
+
     void update(const UpdateContext& ctxt) override
     {
         ComponentManager& component = *ctxt.component;
         const float dt = ctxt.tDt.asSeconds();
-        std::size_t vertexIndex = 0;
-        m_vertices.resize(m_particles.size() * 4);
 
         assert(m_collisionSystem && "ParticleSystem: collision pointer null");
 
@@ -31,30 +35,24 @@ public:
         sf::FloatRect playerBounds;
         sf::Vector2f playerCenter{0.f, 0.f};
         sf::Vector2f playerVel{0.f, 0.f};
-        for (Entity entity : entities)
+        for (auto [entity, player, pos, col, vel] : component.view<PlayerComponent, Position, ColliderComponent, Velocity>())
         {
-            if (component.hasComponent<PlayerComponent>(entity))
-            {
-                hasPlayer = true;
-                auto& pos  = component.getComponent<Position>(entity);
-                auto& col  = component.getComponent<ColliderComponent>(entity);
-                auto& vel = component.getComponent<Velocity>(entity);
-                playerBounds = sf::FloatRect
-                (
-                    pos.x + col.bounds.left,
-                    pos.y + col.bounds.top,
-                    col.bounds.width,
-                    col.bounds.height
-                );
-
-                playerCenter = sf::Vector2f
-                (
-                    playerBounds.left + playerBounds.width  * 0.5f,
-                    playerBounds.top  + playerBounds.height * 0.5f
-                );
-                playerVel = {vel.dx, vel.dy};
-                break;
-            }
+            hasPlayer = true;
+            playerBounds = sf::FloatRect
+            (
+                pos.x + col.bounds.left,
+                pos.y + col.bounds.top,
+                col.bounds.width,
+                col.bounds.height
+            );
+
+            playerCenter = sf::Vector2f
+            (
+                playerBounds.left + playerBounds.width  * 0.5f,
+                playerBounds.top  + playerBounds.height * 0.5f
+            );
+            playerVel = {vel.dx, vel.dy};
+            break;
         }
 
         // Compute player velocity for directional push
@@ -74,132 +72,110 @@ public:
         constexpr float playerBounce = 0.2f;
         static std::normal_distribution<float> noisDist(0.f, 1.f);
 
-        for (std::size_t i = 0; i < m_particles.size();)
-        {
-            Particle& p = m_particles[i];
-            p.lifeTime -= ctxt.tDt;
-
+        m_pool.age(dt);
+        m_pool.removeDead();
 
-            if (p.lifeTime <= sf::Time::Zero)
-            {
-                m_particles[i] = m_particles.back();
-                m_particles.pop_back();
-                continue;
-            }
+        m_vertices.resize(m_pool.count() * 4);
 
-            p.velocity += m_gravity * dt;
-            sf::Vector2f newPos = p.position + p.velocity * dt;
+        constexpr float bounce = 0.4f; // 60% energy loss on bounce
+        constexpr float tile = 16.f; // tile size
 
+        auto solid = [&](float wx, float wy)
+        {
+            return m_collisionSystem && m_collisionSystem->isSolidAt(wx, wy);
+        };
 
-            constexpr float bounce = 0.4f; // 60% energy loss on bounce
-            constexpr float tile = 16.f; // tile size
+        forEachBatch(ctxt, [&](std::size_t begin, std::size_t end)
+        {
+            m_pool.integrate(m_gravity, dt, begin, end);
 
-            auto solid = [&](float wx, float wy)
+            for (std::size_t i = begin; i < end; ++i)
             {
-                return m_collisionSystem && m_collisionSystem->isSolidAt(component, wx, wy);
-            };
+                sf::Vector2f newPos{m_pool.x[i], m_pool.y[i]};
+                sf::Vector2f velocity{m_pool.vx[i], m_pool.vy[i]};
+                float size = m_pool.size[i];
 
-            // sample point one half-size below center
-            if (solid(newPos.x, newPos.y + p.size * 0.5f) && p.velocity.y > 10)
-            {
-                newPos.y = std::floor((newPos.y + p.size * 0.5f) / tile) * tile - p.size * 0.5f;
-                p.velocity.y *= -bounce; // damp and invert vertical
-            }
+                // sample point one half-size below center
+                if (solid(newPos.x, newPos.y + size * 0.5f) && velocity.y > 10)
+                {
+                    newPos.y = std::floor((newPos.y + size * 0.5f) / tile) * tile - size * 0.5f;
+                    velocity.y *= -bounce; // damp and invert vertical
+                }
 
-            // wall check
-            if (solid(newPos.x + p.size * 0.5f, newPos.y) ||
-                solid(newPos.x - p.size * 0.5f, newPos.y))
-            {
-                p.velocity.x *= -bounce; // damp and invert horizontal
-            }
+                // wall check
+                if (solid(newPos.x + size * 0.5f, newPos.y) ||
+                    solid(newPos.x - size * 0.5f, newPos.y))
+                {
+                    velocity.x *= -bounce; // damp and invert horizontal
+                }
 
-            if (hasPlayer)
-            {
+                if (hasPlayer)
                 {
-                    sf::Vector2f diffCenter = newPos - playerCenter;
-                    float d2center = diffCenter.x*diffCenter.x + diffCenter.y*diffCenter.y;
-                    if (d2center < influenceRadius * influenceRadius)
                     {
-                        float d = std::sqrt(d2center);
-                        if (d > 0.f)
+                        sf::Vector2f diffCenter = newPos - playerCenter;
+                        float d2center = diffCenter.x*diffCenter.x + diffCenter.y*diffCenter.y;
+                        if (d2center < influenceRadius * influenceRadius)
                         {
-                            sf::Vector2f pushDir = diffCenter / d;
-                            float factor = 1.f - (d / influenceRadius);
-                            // apply a gentle fling outward
-                            p.velocity += pushDir * (radialStrength * factor * dt);
+                            float d = std::sqrt(d2center);
+                            if (d > 0.f)
+                            {
+                                sf::Vector2f pushDir = diffCenter / d;
+                                float factor = 1.f - (d / influenceRadius);
+                                // apply a gentle fling outward
+                                velocity += pushDir * (radialStrength * factor * dt);
+                            }
                         }
                     }
-                }
-                float radius  = p.size * 0.5f;
-                float cx      = newPos.x;
-                float cy      = newPos.y;
-                float nearestX = std::clamp(cx, playerBounds.left,
-                                            playerBounds.left + playerBounds.width);
-                float nearestY = std::clamp(cy, playerBounds.top,
-                                            playerBounds.top  + playerBounds.height);
-
-                float dx   = cx - nearestX;
-                float dy   = cy - nearestY;
-                float dist2 = dx*dx + dy*dy;
-
-                if (dist2 < radius*radius)
-                {
-                    float dist = std::sqrt(dist2);
-                    if (dist > 0.f)
+                    float radius  = size * 0.5f;
+                    float cx      = newPos.x;
+                    float cy      = newPos.y;
+                    float nearestX = std::clamp(cx, playerBounds.left,
+                                                playerBounds.left + playerBounds.width);
+                    float nearestY = std::clamp(cy, playerBounds.top,
+                                                playerBounds.top  + playerBounds.height);
+
+                    float dx   = cx - nearestX;
+                    float dy   = cy - nearestY;
+                    float dist2 = dx*dx + dy*dy;
+
+                    if (dist2 < radius*radius)
                     {
-                        sf::Vector2f normal{ dx/dist, dy/dist };
+                        float dist = std::sqrt(dist2);
+                        if (dist > 0.f)
+                        {
+                            sf::Vector2f normal{ dx/dist, dy/dist };
 
-                        // Stronger interpenetration resolution (3x)
-                        float penetration = radius - dist + 0.001f;
-                        newPos += normal * (penetration * 3.f);
+                            // Stronger interpenetration resolution (3x)
+                            float penetration = radius - dist + 0.001f;
+                            newPos += normal * (penetration * 3.f);
 
-                        // Enhanced restitution: amplify bounce effect
-                        float vRelN = p.velocity.x*normal.x + p.velocity.y*normal.y;
-                        float e = playerBounce * 2.f; // stronger bounce
-                        p.velocity -= (1.f + e) * vRelN * normal;
+                            // Enhanced restitution: amplify bounce effect
+                            float vRelN = velocity.x*normal.x + velocity.y*normal.y;
+                            float e = playerBounce * 2.f; // stronger bounce
+                            velocity -= (1.f + e) * vRelN * normal;
 
-                        // Directional push: inherit a larger fraction of player velocity
-                        p.velocity += playerVel * (dirStrength * 2.f);
+                            // Directional push: inherit a larger fraction of player velocity
+                            velocity += playerVel * (dirStrength * 2.f);
 
-                        // Tangential friction to simulate drag along surface
-                        sf::Vector2f tangent{ -normal.y, normal.x };
-                        float vRelT = p.velocity.x*tangent.x + p.velocity.y*tangent.y;
-                        p.velocity -= COLLISION_FRICTION * vRelT * tangent;
+                            // Tangential friction to simulate drag along surface
+                            sf::Vector2f tangent{ -normal.y, normal.x };
+                            float vRelT = velocity.x*tangent.x + velocity.y*tangent.y;
+                            velocity -= COLLISION_FRICTION * vRelT * tangent;
+                        }
                     }
                 }
-            }
 
-            p.position = newPos;
+                m_pool.x[i] = newPos.x;
+                m_pool.y[i] = newPos.y;
+                m_pool.vx[i] = velocity.x;
+                m_pool.vy[i] = velocity.y;
 
-            float half = p.size * 0.5f;
-            float lifeRatio = p.lifeTime.asSeconds() / m_lifetime.asSeconds();
-            auto alpha = static_cast<sf::Uint8>(lifeRatio * 255);
+                float lifeRatio = m_pool.life[i] / m_lifetime.asSeconds();
+                auto alpha = static_cast<sf::Uint8>(lifeRatio * 255);
 
-            sf::Color color(0, 0, 255, alpha);
-
-            // 4 vertices per quad (TL, TR, BR, BL)
-            m_vertices[vertexIndex + 0].position = { newPos.x - half, newPos.y - half };
-            m_vertices[vertexIndex + 1].position = { newPos.x + half, newPos.y - half };
-            m_vertices[vertexIndex + 2].position = { newPos.x + half, newPos.y + half };
-            m_vertices[vertexIndex + 3].position = { newPos.x - half, newPos.y + half };
-
-            m_vertices[vertexIndex + 0].color = color;
-            m_vertices[vertexIndex + 1].color = color;
-            m_vertices[vertexIndex + 2].color = color;
-            m_vertices[vertexIndex + 3].color = color;
-
-            auto ts = m_texture.getSize();
-            auto tw = float(ts.x), th = float(ts.y);
-
-            m_vertices[vertexIndex + 0].texCoords = {0.f, 0.f};
-            m_vertices[vertexIndex + 1].texCoords = {tw, 0.f};
-            m_vertices[vertexIndex + 2].texCoords = {tw, th};
-            m_vertices[vertexIndex + 3].texCoords = {0.f, th};
-
-            vertexIndex += 4;
-
-            ++i;
-        }
+                writeQuad(i * 4, newPos.x, newPos.y, size * 0.5f, sf::Color(0, 0, 255, alpha), true);
+            }
+        });
     }
 protected:
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override
@@ -18,14 +18,15 @@ public:
     sf::Vector2f m_lastPlayerPos{0.f, 0.f};
     bool m_firstFrame{true};
 
+    GaseousParticleSystem() {
+        readsComponents<PlayerComponent, Position, ColliderComponent, Velocity>();
+        writesResources<GaseousParticleSystem>();
+    }
+
     void update(const UpdateContext& ctxt) override {
         ComponentManager& component = *ctxt.component;
         const float dt   = ctxt.tDt.asSeconds();
-        size_t  vIndex   = 0;
 
-        // Resize vertex buffer
-        m_vertices.clear();
-        m_vertices.resize(m_particles.size() * 4);
         assert(m_collisionSystem && "ParticleSystem: collision pointer null");
 
         // Find player bounds and center
@@ -33,26 +34,21 @@ public:
         sf::FloatRect playerBounds;
         sf::Vector2f playerCenter{0.f, 0.f};
         sf::Vector2f playerVel{0.f, 0.f};
-        for (Entity entity : entities) {
-            if (component.hasComponent<PlayerComponent>(entity)) {
-                hasPlayer = true;
-                auto& pos  = component.getComponent<Position>(entity);
-                auto& col  = component.getComponent<ColliderComponent>(entity);
-                auto& vel = component.getComponent<Velocity>(entity);
-                playerBounds = sf::FloatRect(
-                    pos.x + col.bounds.left,
-                    pos.y + col.bounds.top,
-                    col.bounds.width,
-                    col.bounds.height
-                );
-
-                playerCenter = sf::Vector2f(
-                    playerBounds.left + playerBounds.width  * 0.5f,
-                    playerBounds.top  + playerBounds.height * 0.5f
-                );
-                playerVel = {vel.dx, vel.dy};
-                break;
-            }
+        for (auto [entity, player, pos, col, vel] : component.view<PlayerComponent, Position, ColliderComponent, Velocity>()) {
+            hasPlayer = true;
+            playerBounds = sf::FloatRect(
+                pos.x + col.bounds.left,
+                pos.y + col.bounds.top,
+                col.bounds.width,
+                col.bounds.height
+            );
+
+            playerCenter = sf::Vector2f(
+                playerBounds.left + playerBounds.width  * 0.5f,
+                playerBounds.top  + playerBounds.height * 0.5f
+            );
+            playerVel = {vel.dx, vel.dy};
+            break;
         }
 
         // Compute player velocity for directional push
@@ -74,167 +70,155 @@ public:
         constexpr float jitterAmt       = 30.f;
         constexpr float swirlAmt        = 20.f;
         constexpr float tileSize        = 16.f;
-        static std::normal_distribution<float> noiseDist(0.f, 1.f);
 
-        for (size_t i = 0; i < m_particles.size();) {
-            auto& p = m_particles[i];
-
-            // Age & remove dead
-            p.lifeTime -= ctxt.tDt;
-            if (p.lifeTime <= sf::Time::Zero) {
-                p = m_particles.back();
-                m_particles.pop_back();
-                continue;
-            }
-
-            // Gravity & integrate
-            p.velocity -= sf::Vector2f{0.f, 120.f} * dt;
-            sf::Vector2f newPos = p.position + p.velocity * dt;
-
-            // Tile collisions (existing)
-            auto solid = [&](float x, float y) {
-                return m_collisionSystem->isSolidAt(component, x, y);
-            };
-            if (solid(newPos.x, newPos.y + p.size*0.5f) && p.velocity.y > 10.f) {
-                newPos.y = std::floor((newPos.y + p.size*0.5f)/tileSize)*tileSize - p.size*0.5f;
-                p.velocity.y *= -wallBounce;
-            }
-            if (solid(newPos.x + p.size*0.5f, newPos.y) ||
-                solid(newPos.x - p.size*0.5f, newPos.y)) {
-                p.velocity.x *= -wallBounce;
-            }
+        // Age & remove dead, then gravity & integrate per batch
+        m_pool.age(dt);
+        m_pool.removeDead();
 
-            // --- Improved Player Collision (stronger push) ---
-            if (hasPlayer) {
+        // Resize vertex buffer
+        m_vertices.resize(m_pool.count() * 4);
+
+        forEachBatch(ctxt, [&](std::size_t begin, std::size_t end) {
+            std::mt19937 jitterRng = batchRng(begin); // Per batch so threads never share an engine
+            std::normal_distribution<float> noiseDist(0.f, 1.f);
+
+            m_pool.integrate({0.f, -120.f}, dt, begin, end);
+
+            for (size_t i = begin; i < end; ++i) {
+                sf::Vector2f newPos{m_pool.x[i], m_pool.y[i]};
+                sf::Vector2f velocity{m_pool.vx[i], m_pool.vy[i]};
+                float size = m_pool.size[i];
+
+                // Tile collisions (existing)
+                auto solid = [&](float x, float y) {
+                    return m_collisionSystem->isSolidAt(x, y);
+                };
+                if (solid(newPos.x, newPos.y + size*0.5f) && velocity.y > 10.f) {
+                    newPos.y = std::floor((newPos.y + size*0.5f)/tileSize)*tileSize - size*0.5f;
+                    velocity.y *= -wallBounce;
+                }
+                if (solid(newPos.x + size*0.5f, newPos.y) ||
+                    solid(newPos.x - size*0.5f, newPos.y)) {
+                    velocity.x *= -wallBounce;
+                }
 
-                {
-                    sf::Vector2f diffCenter = newPos - playerCenter;
-                    float d2center = diffCenter.x*diffCenter.x + diffCenter.y*diffCenter.y;
-                    if (d2center < influenceRadius * influenceRadius) {
-                        float d = std::sqrt(d2center);
-                        if (d > 0.f) {
-                            sf::Vector2f pushDir = diffCenter / d;
-                            float factor = 1.f - (d / influenceRadius);
-                            // apply a gentle fling outward
-                            p.velocity += pushDir * (radialStrength * factor * dt);
+                // --- Improved Player Collision (stronger push) ---
+                if (hasPlayer) {
+
+                    {
+                        sf::Vector2f diffCenter = newPos - playerCenter;
+                        float d2center = diffCenter.x*diffCenter.x + diffCenter.y*diffCenter.y;
+                        if (d2center < influenceRadius * influenceRadius) {
+                            float d = std::sqrt(d2center);
+                            if (d > 0.f) {
+                                sf::Vector2f pushDir = diffCenter / d;
+                                float factor = 1.f - (d / influenceRadius);
+                                // apply a gentle fling outward
+                                velocity += pushDir * (radialStrength * factor * dt);
+                            }
                         }
                     }
-                }
 
-                float radius  = p.size * 0.5f;
-                float cx      = newPos.x;
-                float cy      = newPos.y;
-                float nearestX = std::clamp(cx, playerBounds.left,
-                                            playerBounds.left + playerBounds.width);
-                float nearestY = std::clamp(cy, playerBounds.top,
-                                            playerBounds.top  + playerBounds.height);
-
-                float dx   = cx - nearestX;
-                float dy   = cy - nearestY;
-                float dist2 = dx*dx + dy*dy;
-
-                if (dist2 < radius*radius) {
-                    float dist = std::sqrt(dist2);
-                    if (dist > 0.f) {
-                        sf::Vector2f normal{ dx/dist, dy/dist };
-
-                        // Stronger interpenetration resolution (3x)
-                        float penetration = radius - dist + 0.001f;
-                        newPos += normal * (penetration * 3.f);
-
-                        // Enhanced restitution: amplify bounce effect
-                        float vRelN = p.velocity.x*normal.x + p.velocity.y*normal.y;
-                        float e = playerBounce * 2.f; // stronger bounce
-                        p.velocity -= (1.f + e) * vRelN * normal;
-
-                        // Directional push: inherit a larger fraction of player velocity
-                        p.velocity += playerVel * (dirStrength * 2.f);
-
-                        // Tangential friction to simulate drag along surface
-                        sf::Vector2f tangent{ -normal.y, normal.x };
-                        float vRelT = p.velocity.x*tangent.x + p.velocity.y*tangent.y;
-                        p.velocity -= COLLISION_FRICTION * vRelT * tangent;
+                    float radius  = size * 0.5f;
+                    float cx      = newPos.x;
+                    float cy      = newPos.y;
+                    float nearestX = std::clamp(cx, playerBounds.left,
+                                                playerBounds.left + playerBounds.width);
+                    float nearestY = std::clamp(cy, playerBounds.top,
+                                                playerBounds.top  + playerBounds.height);
+
+                    float dx   = cx - nearestX;
+                    float dy   = cy - nearestY;
+                    float dist2 = dx*dx + dy*dy;
+
+                    if (dist2 < radius*radius) {
+                        float dist = std::sqrt(dist2);
+                        if (dist > 0.f) {
+                            sf::Vector2f normal{ dx/dist, dy/dist };
+
+                            // Stronger interpenetration resolution (3x)
+                            float penetration = radius - dist + 0.001f;
+                            newPos += normal * (penetration * 3.f);
+
+                            // Enhanced restitution: amplify bounce effect
+                            float vRelN = velocity.x*normal.x + velocity.y*normal.y;
+                            float e = playerBounce * 2.f; // stronger bounce
+                            velocity -= (1.f + e) * vRelN * normal;
+
+                            // Directional push: inherit a larger fraction of player velocity
+                            velocity += playerVel * (dirStrength * 2.f);
+
+                            // Tangential friction to simulate drag along surface
+                            sf::Vector2f tangent{ -normal.y, normal.x };
+                            float vRelT = velocity.x*tangent.x + velocity.y*tangent.y;
+                            velocity -= COLLISION_FRICTION * vRelT * tangent;
+                        }
                     }
                 }
-            }
 
-            // Drag
-            p.velocity *= std::max(0.f, 1.f - drag * dt);
+                // Drag
+                velocity *= std::max(0.f, 1.f - drag * dt);
 
-            // Jitter
-            p.velocity += sf::Vector2f(noiseDist(rng), noiseDist(rng)) * jitterAmt * dt;
+                // Jitter
+                velocity += sf::Vector2f(noiseDist(jitterRng), noiseDist(jitterRng)) * jitterAmt * dt;
 
-            // Swirl around emitter
-            {
-                sf::Vector2f dir = newPos - m_emitter;
-                float d2 = dir.x*dir.x + dir.y*dir.y;
-                if (d2 > 0.f) {
-                    float inv = 1.f / std::sqrt(d2);
-                    sf::Vector2f perp{ -dir.y*inv, dir.x*inv };
-                    p.velocity += perp * swirlAmt * dt;
+                // Swirl around emitter
+                {
+                    sf::Vector2f dir = newPos - m_emitter;
+                    float d2 = dir.x*dir.x + dir.y*dir.y;
+                    if (d2 > 0.f) {
+                        float inv = 1.f / std::sqrt(d2);
+                        sf::Vector2f perp{ -dir.y*inv, dir.x*inv };
+                        velocity += perp * swirlAmt * dt;
+                    }
                 }
-            }
-
-            // Commit new position
-            p.position = newPos;
 
-            // Build vertex quad (existing)
-            float half      = p.size * 0.5f;
-            float lifeRatio = p.lifeTime.asSeconds() / m_lifetime.asSeconds();
-            sf::Uint8 alpha = static_cast<sf::Uint8>(lifeRatio * 255);
+                // Commit new position
+                m_pool.x[i] = newPos.x;
+                m_pool.y[i] = newPos.y;
+                m_pool.vx[i] = velocity.x;
+                m_pool.vy[i] = velocity.y;
 
-            float ageRatio = 1.0f - lifeRatio;
-            sf::Color orange(255, 150, 0, 255);
-            sf::Color red(255, 0, 0, 255);
-            sf::Color smoke(80, 80, 80, 0);
+                // Build vertex quad (existing)
+                float half      = size * 0.5f;
+                float lifeRatio = m_pool.life[i] / m_lifetime.asSeconds();
+                sf::Uint8 alpha = static_cast<sf::Uint8>(lifeRatio * 255);
 
-            sf::Color currentColor;
+                float ageRatio = 1.0f - lifeRatio;
+                sf::Color orange(255, 150, 0, 255);
+                sf::Color red(255, 0, 0, 255);
+                sf::Color smoke(80, 80, 80, 0);
 
-            float transitionPoint = 0.6f;
-
-            if (ageRatio < transitionPoint)
-            {
-                float localRatio = ageRatio / transitionPoint;
-
-                sf::Uint8 r = static_cast<sf::Uint8>(orange.r + localRatio * (red.r - orange.r));
-                sf::Uint8 g = static_cast<sf::Uint8>(orange.g + localRatio * (red.g - orange.g));
-                sf::Uint8 b = static_cast<sf::Uint8>(orange.b + localRatio * (red.b - orange.b));
-                sf::Uint8 a = static_cast<sf::Uint8>(orange.a + localRatio * (red.a - orange.a));
-
-                currentColor = sf::Color(r, g, b, a);
-            }
-            else
-            {
-                float localRatio = (ageRatio - transitionPoint) / (1.0f - transitionPoint);
+                sf::Color currentColor;
 
-                sf::Uint8 r = static_cast<sf::Uint8>(red.r + localRatio * (smoke.r - red.r));
-                sf::Uint8 g = static_cast<sf::Uint8>(red.g + localRatio * (smoke.g - red.g));
-                sf::Uint8 b = static_cast<sf::Uint8>(red.b + localRatio * (smoke.b - red.b));
-                sf::Uint8 a = static_cast<sf::Uint8>(red.a + localRatio * (smoke.a - red.a));
+                float transitionPoint = 0.6f;
 
-                currentColor = sf::Color(r, g, b, a);
-            }
+                if (ageRatio < transitionPoint)
+                {
+                    float localRatio = ageRatio / transitionPoint;
 
-            auto ts        = m_texture.getSize();
-            float tw       = static_cast<float>(ts.x);
-            float th       = static_cast<float>(ts.y);
+                    sf::Uint8 r = static_cast<sf::Uint8>(orange.r + localRatio * (red.r - orange.r));
+                    sf::Uint8 g = static_cast<sf::Uint8>(orange.g + localRatio * (red.g - orange.g));
+                    sf::Uint8 b = static_cast<sf::Uint8>(orange.b + localRatio * (red.b - orange.b));
+                    sf::Uint8 a = static_cast<sf::Uint8>(orange.a + localRatio * (red.a - orange.a));
 
-            m_vertices[vIndex+0].position = { newPos.x - half, newPos.y - half };
-            m_vertices[vIndex+1].position = { newPos.x + half, newPos.y - half };
-            m_vertices[vIndex+2].position = { newPos.x + half, newPos.y + half };
-            m_vertices[vIndex+3].position = { newPos.x - half, newPos.y + half };
+                    currentColor = sf::Color(r, g, b, a);
+                }
+                else
+                {
+                    float localRatio = (ageRatio - transitionPoint) / (1.0f - transitionPoint);
 
-            m_vertices[vIndex+0].texCoords = { 0.f,  0.f };
-            m_vertices[vIndex+1].texCoords = { tw,   0.f };
-            m_vertices[vIndex+2].texCoords = { tw,   th };
-            m_vertices[vIndex+3].texCoords = { 0.f,  th };
+                    sf::Uint8 r = static_cast<sf::Uint8>(red.r + localRatio * (smoke.r - red.r));
+                    sf::Uint8 g = static_cast<sf::Uint8>(red.g + localRatio * (smoke.g - red.g));
+                    sf::Uint8 b = static_cast<sf::Uint8>(red.b + localRatio * (smoke.b - red.b));
+                    sf::Uint8 a = static_cast<sf::Uint8>(red.a + localRatio * (smoke.a - red.a));
 
-            for (int j = 0; j < 4; ++j)
-                m_vertices[vIndex+j].color = currentColor;
+                    currentColor = sf::Color(r, g, b, a);
+                }
 
-            vIndex += 4;
-            ++i;
-        }
+                writeQuad(i * 4, newPos.x, newPos.y, half, currentColor, true);
+            }
+        });
     }
 
 protected:
@@ -3,100 +3,91 @@
 
 #include "Engine/Core/UpdateContext.h"
 #include "ParticleSystemBase.h"
+#include "Engine/Components/PlayerComponent.h"
+#include "Engine/Components/Position.h"
 
 
 class HomingParticleSystem : public ParticleSystem {
 public:
+    HomingParticleSystem() {
+        readsComponents<PlayerComponent, Position>();
+        writesResources<HomingParticleSystem>();
+    }
 
     void update(const UpdateContext& ctxt) override
     {
         ComponentManager& component = *ctxt.component;
 
         const float dtSec = ctxt.tDt.asSeconds();
-        std::size_t vertexIndex = 0;
-        m_vertices.resize(m_particles.size() * 4);
 
         assert(m_collisionSystem && "ParticleSystem: collision pointer null");
 
-        auto it = entities.begin();
-        Entity player = *it;
-
-        auto& pos = component.getComponent<Position>(player);
-        sf::Vector2f playerPos = {pos.x, pos.y};
+        sf::Vector2f playerPos{0.f, 0.f};
+        if (component.track<PlayerComponent, Position>(m_player, *ctxt.entity))
+        {
+            auto& pos = component.getComponent<Position>(m_player.index);
+            playerPos = {pos.x, pos.y};
+        }
 
-        for (std::size_t i = 0; i < m_particles.size();) {
-            Particle& p = m_particles[i];
+        m_pool.age(dtSec);
+        m_pool.removeDead();
 
-            p.size = 10;
+        m_vertices.resize(m_pool.count() * 4);
 
-            sf::Vector2f direction = playerPos - p.position;
+        constexpr float bounce = 0.4f; // 60% energy loss on bounce
+        constexpr float tile = 16.f; // tile size
 
-            float lengthVal = length(direction);
+        auto solid = [&](float wx, float wy) {
+            return m_collisionSystem && m_collisionSystem->isSolidAt(wx, wy);
+        };
 
-            if (lengthVal != 0.f)
-                direction /= lengthVal;
-            else
-                direction = {0.f, 0.f};
+        forEachBatch(ctxt, [&](std::size_t begin, std::size_t end) {
+            // Steer every particle towards the player
+            for (std::size_t i = begin; i < end; ++i) {
+                m_pool.size[i] = 10;
 
-            float speed = 200.f;
-            sf::Vector2f desiredVelocity = direction * speed;
-            p.velocity += (desiredVelocity - p.velocity) * 0.1f; // smoothing factor
+                sf::Vector2f direction = playerPos - sf::Vector2f{m_pool.x[i], m_pool.y[i]};
 
-            p.lifeTime -= ctxt.tDt;
+                float lengthVal = length(direction);
 
+                if (lengthVal != 0.f)
+                    direction /= lengthVal;
+                else
+                    direction = {0.f, 0.f};
 
-            if (p.lifeTime <= sf::Time::Zero) {
-                m_particles[i] = m_particles.back();
-                m_particles.pop_back();
-                continue;
+                float speed = 200.f;
+                sf::Vector2f desiredVelocity = direction * speed;
+                m_pool.vx[i] += (desiredVelocity.x - m_pool.vx[i]) * 0.1f; // smoothing factor
+                m_pool.vy[i] += (desiredVelocity.y - m_pool.vy[i]) * 0.1f;
             }
 
-            p.velocity += m_gravity * dtSec;
-            sf::Vector2f newPos = p.position + p.velocity * dtSec;
-
+            m_pool.integrate(m_gravity, dtSec, begin, end);
 
-            constexpr float bounce = 0.4f; // 60% energy loss on bounce
-            constexpr float tile = 16.f; // tile size
+            for (std::size_t i = begin; i < end; ++i) {
+                float &x = m_pool.x[i];
+                float &y = m_pool.y[i];
+                float &vx = m_pool.vx[i];
+                float &vy = m_pool.vy[i];
+                float size = m_pool.size[i];
 
-            auto solid = [&](float wx, float wy) {
-                return m_collisionSystem && m_collisionSystem->isSolidAt(component, wx, wy);
-            };
-
-            // sample point one half-size below center
-            if (solid(newPos.x, newPos.y + p.size * 0.5f) && p.velocity.y > 10) {
-                newPos.y = std::floor((newPos.y + p.size * 0.5f) / tile) * tile - p.size * 0.5f;
-                p.velocity.y *= -bounce; // damp and invert vertical
-            }
-
-            // wall check
-            if (solid(newPos.x + p.size * 0.5f, newPos.y) ||
-                solid(newPos.x - p.size * 0.5f, newPos.y)) {
-                p.velocity.x *= -bounce; // damp and invert horizontal
+                // sample point one half-size below center
+                if (solid(x, y + size * 0.5f) && vy > 10) {
+                    y = std::floor((y + size * 0.5f) / tile) * tile - size * 0.5f;
+                    vy *= -bounce; // damp and invert vertical
                 }
 
-            p.position = newPos;
-
-            float half = p.size * 0.5f;
-            float lifeRatio = p.lifeTime.asSeconds() / m_lifetime.asSeconds();
-            auto alpha = static_cast<sf::Uint8>(lifeRatio * 255);
-
-            sf::Color color(0, 0, 255, alpha);
-
-            // 4 vertices per quad (TL, TR, BR, BL)
-            m_vertices[vertexIndex + 0].position = { newPos.x - half, newPos.y - half };
-            m_vertices[vertexIndex + 1].position = { newPos.x + half, newPos.y - half };
-            m_vertices[vertexIndex + 2].position = { newPos.x + half, newPos.y + half };
-            m_vertices[vertexIndex + 3].position = { newPos.x - half, newPos.y + half };
-
-            m_vertices[vertexIndex + 0].color = color;
-            m_vertices[vertexIndex + 1].color = color;
-            m_vertices[vertexIndex + 2].color = color;
-            m_vertices[vertexIndex + 3].color = color;
+                // wall check
+                if (solid(x + size * 0.5f, y) ||
+                    solid(x - size * 0.5f, y)) {
+                    vx *= -bounce; // damp and invert horizontal
+                }
 
-            vertexIndex += 4;
+                float lifeRatio = m_pool.life[i] / m_lifetime.asSeconds();
+                auto alpha = static_cast<sf::Uint8>(lifeRatio * 255);
 
-            ++i;
-        }
+                writeQuad(i * 4, x, y, size * 0.5f, sf::Color(0, 0, 255, alpha), false);
+            }
+        });
     }
 
 protected:
@@ -116,6 +107,8 @@ protected:
         p.position = m_emitter;
     }
 
+    EntityHandle m_player; // Homing target, kept across frames
+
     static std::uniform_real_distribution<float> angleDeg;
     static std::uniform_real_distribution<float> speedDist;
     static std::uniform_real_distribution<float> sizeDist;
@@ -0,0 +1,162 @@
+#ifndef PARTICLEPOOL_H
+#define PARTICLEPOOL_H
+
+#include <cstddef>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTICLE_POOL_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_POOL_SSE 1
+#endif
+
+/**
+ * @brief Structure-of-arrays particle storage.
+ *        Every attribute lives in its own contiguous float array so the bulk kernels
+ *        (age, integrate, removeDead) can process several particles per instruction.
+ *        AVX is used when the engine is compiled with it, SSE2 on other x86 targets,
+ *        and plain loops everywhere else.
+ */
+class ParticlePool {
+public:
+    std::vector<float> x, y; // Position
+    std::vector<float> vx, vy; // Velocity
+    std::vector<float> life; // Seconds left
+    std::vector<float> size;
+
+    std::size_t count() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+
+    void reserve(std::size_t n) {
+        x.reserve(n);
+        y.reserve(n);
+        vx.reserve(n);
+        vy.reserve(n);
+        life.reserve(n);
+        size.reserve(n);
+    }
+
+    void clear() { resize(0); }
+
+    void push(sf::Vector2f position, sf::Vector2f velocity, float lifeSeconds, float particleSize) {
+        x.push_back(position.x);
+        y.push_back(position.y);
+        vx.push_back(velocity.x);
+        vy.push_back(velocity.y);
+        life.push_back(lifeSeconds);
+        size.push_back(particleSize);
+    }
+
+    // life -= dt
+    void age(float dt) {
+        std::size_t n = count();
+        float *l = life.data();
+        std::size_t i = 0;
+#if defined(PARTICLE_POOL_AVX)
+        __m256 d = _mm256_set1_ps(dt);
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(l + i, _mm256_sub_ps(_mm256_loadu_ps(l + i), d));
+        }
+#elif defined(PARTICLE_POOL_SSE)
+        __m128 d = _mm_set1_ps(dt);
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(l + i, _mm_sub_ps(_mm_loadu_ps(l + i), d));
+        }
+#endif
+        for (; i < n; ++i) {
+            l[i] -= dt;
+        }
+    }
+
+    // v += acceleration * dt, then position += v * dt
+    void integrate(sf::Vector2f acceleration, float dt) {
+        integrate(acceleration, dt, 0, count());
+    }
+
+    // Same as above for the particles in [begin, end) only.
+    void integrate(sf::Vector2f acceleration, float dt, std::size_t begin, std::size_t end) {
+        std::size_t n = end - begin;
+        float *px = x.data() + begin, *py = y.data() + begin, *pvx = vx.data() + begin, *pvy = vy.data() + begin;
+        float ax = acceleration.x * dt;
+        float ay = acceleration.y * dt;
+        std::size_t i = 0;
+#if defined(PARTICLE_POOL_AVX)
+        __m256 dax = _mm256_set1_ps(ax), day = _mm256_set1_ps(ay), d = _mm256_set1_ps(dt);
+        for (; i + 8 <= n; i += 8) {
+            __m256 velX = _mm256_add_ps(_mm256_loadu_ps(pvx + i), dax);
+            __m256 velY = _mm256_add_ps(_mm256_loadu_ps(pvy + i), day);
+            _mm256_storeu_ps(pvx + i, velX);
+            _mm256_storeu_ps(pvy + i, velY);
+            _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(velX, d)));
+            _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(velY, d)));
+        }
+#elif defined(PARTICLE_POOL_SSE)
+        __m128 dax = _mm_set1_ps(ax), day = _mm_set1_ps(ay), d = _mm_set1_ps(dt);
+        for (; i + 4 <= n; i += 4) {
+            __m128 velX = _mm_add_ps(_mm_loadu_ps(pvx + i), dax);
+            __m128 velY = _mm_add_ps(_mm_loadu_ps(pvy + i), day);
+            _mm_storeu_ps(pvx + i, velX);
+            _mm_storeu_ps(pvy + i, velY);
+            _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(velX, d)));
+            _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velY, d)));
+        }
+#endif
+        for (; i < n; ++i) {
+            pvx[i] += ax;
+            pvy[i] += ay;
+            px[i] += pvx[i] * dt;
+            py[i] += pvy[i] * dt;
+        }
+    }
+
+    /**
+     * @brief Drops every particle whose life has run out, keeping the survivors in order.
+     *        Whole blocks of live particles are skipped with one compare while nothing has
+     *        been removed yet, which is the common case.
+     */
+    void removeDead() {
+        std::size_t n = count();
+        const float *l = life.data();
+        std::size_t i = 0;
+#if defined(PARTICLE_POOL_AVX)
+        __m256 zero = _mm256_setzero_ps();
+        while (i + 8 <= n && _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(l + i), zero, _CMP_LE_OQ)) == 0) {
+            i += 8;
+        }
+#elif defined(PARTICLE_POOL_SSE)
+        __m128 zero = _mm_setzero_ps();
+        while (i + 4 <= n && _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(l + i), zero)) == 0) {
+            i += 4;
+        }
+#endif
+        std::size_t write = i;
+        for (; i < n; ++i) {
+            if (life[i] <= 0.f) continue;
+            if (write != i) {
+                x[write] = x[i];
+                y[write] = y[i];
+                vx[write] = vx[i];
+                vy[write] = vy[i];
+                life[write] = life[i];
+                size[write] = size[i];
+            }
+            ++write;
+        }
+        resize(write);
+    }
+
+private:
+    void resize(std::size_t n) {
+        x.resize(n);
+        y.resize(n);
+        vx.resize(n);
+        vy.resize(n);
+        life.resize(n);
+        size.resize(n);
+    }
+};
+
+#endif
@@ -2,37 +2,63 @@
 #define PARTICLESYSTEMBASE_H
 
 #include <SFML/Graphics.hpp>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <random>
 #include <cmath>
+#include <cstdint>
+#include <algorithm>
 
+#include "Engine/Core/JobPool.h"
 #include "Engine/Systems/CollisionSystem.h"
 #include "Engine/System.h"
+#include "ParticlePool.h"
 
 constexpr float COLLISION_FRICTION = 0.3f;
 
 class ParticleSystem : public System, public sf::Drawable, public sf::Transformable {
 public:
-    explicit ParticleSystem(std::size_t maxParticles = 500)
+    static constexpr std::size_t DEFAULT_MAX_PARTICLES = 50000;
+    static constexpr std::size_t BATCH_SIZE = 1024; // Particles per job in update()
+    static constexpr std::uint32_t DEFAULT_SEED = 5489u; // std::mt19937's default seed
+
+    explicit ParticleSystem(std::size_t maxParticles = DEFAULT_MAX_PARTICLES)
         : m_capacity(maxParticles)
     {
-        m_particles.reserve(m_capacity);
         m_vertices.setPrimitiveType(sf::Quads);
-        m_vertices.resize(maxParticles * 4);
+    }
 
-        if(!m_texture.loadFromFile("assets/circleQuadTexture.png"))
+    // Loads the quad texture. Only drawing needs it, headless runs never call this.
+    void loadTexture(const std::string& path = "assets/circleQuadTexture.png")
+    {
+        if(!m_texture.loadFromFile(path))
         {
-            throw std::runtime_error("Could not load 'circleQuadTexture.png'");
+            throw std::runtime_error("Could not load '" + path + "'");
         }
     }
 
     void setCollisionSystem(const CollisionSystem* cs) {m_collisionSystem = cs;}
 
+    // Reseeds spawning and per-batch randomness so a run can be reproduced exactly.
+    void setSeed(std::uint32_t seed)
+    {
+        m_seed = seed;
+        m_frame = 0;
+        rng.seed(seed);
+    }
+
     void setEmitter(const sf::Vector2f& position)
     {
         m_emitter = position;
     }
 
+    // Upper bound on live particles, spawnParticles() stops there.
+    void setMaxParticles(std::size_t maxParticles)
+    {
+        m_capacity = maxParticles;
+    }
+
     void setParticleLifetime(sf::Time lifeTime)
     {
         m_lifetime = lifeTime;
@@ -41,22 +67,31 @@ public:
     void spawnParticles(std::size_t count)
     {
         // Clamping the pool size
-        if (m_particles.size() + count > m_capacity)
+        if (m_pool.count() + count > m_capacity)
         {
-            count = m_capacity - m_particles.size();
+            count = m_capacity - m_pool.count();
         }
         for (std::size_t n = 0; n < count; ++n)
         {
-           Particle p;
+            Particle p;
             resetParticle(p);
-            m_particles.push_back(p);
+            m_pool.push(p.position, p.velocity, p.lifeTime.asSeconds(), p.size);
         }
     }
+
+    std::size_t getParticleCount() const { return m_pool.count(); }
+    // World-space area covered by the particle quads, used by the render system for culling.
+    sf::FloatRect getBounds() const
+    {
+        return getTransform().transformRect(m_vertices.getBounds());
+    }
+
     virtual ~ParticleSystem() = default;
 
     virtual void update(const UpdateContext& ctxt) override = 0;
 
 protected:
+    // Description of a new particle, filled in by resetParticle() and then stored in m_pool.
     struct Particle
     {
         sf::Vector2f velocity;
@@ -68,7 +103,7 @@ protected:
     sf::Texture m_texture;
     std::size_t m_capacity;
     sf::Texture tetxure;
-    std::vector<Particle> m_particles;
+    ParticlePool m_pool;
     sf::VertexArray m_vertices{sf::Points};
     sf::Time m_lifetime{sf::seconds(2.f)};
     sf::Vector2f m_emitter{};
@@ -77,17 +112,68 @@ protected:
 
     const CollisionSystem* m_collisionSystem = nullptr;
 
-    static std::random_device rd;
-    static std::mt19937 rng;
+    std::uint32_t m_seed = DEFAULT_SEED;
+    std::uint64_t m_frame = 0; // Updates run so far, mixed into the batch seeds
+    std::mt19937 rng{DEFAULT_SEED}; // Used when spawning, on the calling thread only
 
     virtual void resetParticle(Particle& p) = 0;
 
+    /**
+     * @brief Calls fn(begin, end) for each BATCH_SIZE slice of m_pool, on the job pool when there is one.
+     *        Every batch must only touch its own particles and their quads in m_vertices.
+     */
+    template<typename Fn>
+    void forEachBatch(const UpdateContext& ctxt, Fn&& fn)
+    {
+        ++m_frame;
+        if (ctxt.jobs)
+        {
+            ctxt.jobs->parallelFor(m_pool.count(), BATCH_SIZE, fn);
+            return;
+        }
+        for (std::size_t begin = 0; begin < m_pool.count(); begin += BATCH_SIZE)
+        {
+            fn(begin, std::min(begin + BATCH_SIZE, m_pool.count()));
+        }
+    }
+
+    // Random engine for the batch starting at begin. Depends only on the seed, frame and batch,
+    // never on which thread runs it, so threaded updates stay deterministic.
+    std::mt19937 batchRng(std::size_t begin) const
+    {
+        std::seed_seq seq{
+            m_seed,
+            static_cast<std::uint32_t>(m_frame),
+            static_cast<std::uint32_t>(m_frame >> 32),
+            static_cast<std::uint32_t>(begin / BATCH_SIZE)
+        };
+        return std::mt19937(seq);
+    }
+
+    // Writes the quad for one particle at m_vertices[vertexIndex .. vertexIndex + 3].
+    void writeQuad(std::size_t vertexIndex, float x, float y, float half, sf::Color color, bool textured) {
+        m_vertices[vertexIndex + 0].position = { x - half, y - half };
+        m_vertices[vertexIndex + 1].position = { x + half, y - half };
+        m_vertices[vertexIndex + 2].position = { x + half, y + half };
+        m_vertices[vertexIndex + 3].position = { x - half, y + half };
+
+        for (std::size_t j = 0; j < 4; ++j)
+            m_vertices[vertexIndex + j].color = color;
+
+        if (textured)
+        {
+            auto ts = m_texture.getSize();
+            auto tw = float(ts.x), th = float(ts.y);
+
+            m_vertices[vertexIndex + 0].texCoords = {0.f, 0.f};
+            m_vertices[vertexIndex + 1].texCoords = {tw, 0.f};
+            m_vertices[vertexIndex + 2].texCoords = {tw, th};
+            m_vertices[vertexIndex + 3].texCoords = {0.f, th};
+        }
+    }
+
    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override = 0;
 
 };
 
-// Static member definitions
-inline std::random_device ParticleSystem::rd;
-inline std::mt19937 ParticleSystem::rng;
-
 #endif
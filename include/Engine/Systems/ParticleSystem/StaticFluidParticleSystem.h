@@ -7,80 +7,60 @@
 class StaticFluidParticleSystem : public ParticleSystem
 {
 public:
+    StaticFluidParticleSystem()
+    {
+        writesResources<StaticFluidParticleSystem>();
+    }
+
     void update(const UpdateContext& ctxt) override
     {
-        auto& components = *ctxt.component;
         const float dt = ctxt.tDt.asSeconds();
-        std::size_t vertexIndex = 0;
-        m_vertices.resize(m_particles.size() * 4);
 
         assert(m_collisionSystem && "ParticleSystem: collision pointer null");
 
-        for (std::size_t i = 0; i < m_particles.size();)
-        {
-            Particle& p = m_particles[i];
-            p.lifeTime -= ctxt.tDt;
+        m_pool.age(dt);
+        m_pool.removeDead();
 
-            if (p.lifeTime <= sf::Time::Zero)
-            {
-                m_particles[i] = m_particles.back();
-                m_particles.pop_back();
-                continue;
-            }
+        m_vertices.resize(m_pool.count() * 4);
 
-            p.velocity += m_gravity * dt;
-            sf::Vector2f newPos = p.position + p.velocity * dt;
+        constexpr float bounce = 0.4f;
+        constexpr float tile = 16.f;
 
-            constexpr float bounce = 0.4f;
-            constexpr float tile = 16.f;
-
-            auto solid = [&](float wx, float wy)
-            {
-                return m_collisionSystem && m_collisionSystem->isSolidAt(components, wx, wy);
-            };
+        auto solid = [&](float wx, float wy)
+        {
+            return m_collisionSystem && m_collisionSystem->isSolidAt(wx, wy);
+        };
 
-            if (solid(newPos.x, newPos.y + p.size * 0.0f) && p.velocity.y > 10)
-            {
-                newPos.y = std::floor((newPos.y + p.size * 0.5f) / tile) * tile - p.size * 0.5f;
-                p.velocity.y *= -bounce;
-            }
+        forEachBatch(ctxt, [&](std::size_t begin, std::size_t end)
+        {
+            m_pool.integrate(m_gravity, dt, begin, end);
 
-            if (solid(newPos.x + p.size * 0.f, newPos.y) ||
-                solid(newPos.x -p.size * 0.5f, newPos.y))
+            for (std::size_t i = begin; i < end; ++i)
             {
-                p.velocity.x *= -bounce;
+                float &x = m_pool.x[i];
+                float &y = m_pool.y[i];
+                float &vx = m_pool.vx[i];
+                float &vy = m_pool.vy[i];
+                float size = m_pool.size[i];
+
+                if (solid(x, y + size * 0.0f) && vy > 10)
+                {
+                    y = std::floor((y + size * 0.5f) / tile) * tile - size * 0.5f;
+                    vy *= -bounce;
+                }
+
+                if (solid(x + size * 0.f, y) ||
+                    solid(x - size * 0.5f, y))
+                {
+                    vx *= -bounce;
+                }
+
+                float lifeRatio = m_pool.life[i] / m_lifetime.asSeconds();
+                auto alpha = static_cast<sf::Uint8>(lifeRatio * 255);
+
+                writeQuad(i * 4, x, y, size * 0.5f, sf::Color(255, 0, 0, alpha), true);
             }
-
-            p.position = newPos;
-
-            float half = p.size * 0.5f;
-            float lifeRatio = p.lifeTime.asSeconds() / m_lifetime.asSeconds();
-            auto alpha = static_cast<sf::Uint8>(lifeRatio * 255);
-
-            sf::Color color(255, 0, 0, alpha);
-
-            m_vertices[vertexIndex + 0].position = { newPos.x - half, newPos.y - half };
-            m_vertices[vertexIndex + 1].position = { newPos.x + half, newPos.y - half };
-            m_vertices[vertexIndex + 2].position = { newPos.x + half, newPos.y + half };
-            m_vertices[vertexIndex + 3].position = { newPos.x - half, newPos.y + half };
-
-            m_vertices[vertexIndex + 0].color = color;
-            m_vertices[vertexIndex + 1].color = color;
-            m_vertices[vertexIndex + 2].color = color;
-            m_vertices[vertexIndex + 3].color = color;
-
-            auto ts = m_texture.getSize();
-            auto tw = float(ts.x), th = float(ts.y);
-
-            m_vertices[vertexIndex + 0].texCoords = {0.f, 0.f};
-            m_vertices[vertexIndex + 1].texCoords = {tw, 0.f};
-            m_vertices[vertexIndex + 2].texCoords = {tw, th};
-            m_vertices[vertexIndex + 3].texCoords = {0.f, th};
-
-            vertexIndex += 4;
-
-            ++i;
-        }
+        });
     }
 
 protected:
@@ -4,24 +4,34 @@
 #include "Engine/System.h"
 #include "Engine/Core/UpdateContext.h"
 #include "Engine/Components/Velocity.h"
+#include "Engine/Components/ProjectileComponent.h"
 
 class PhysicsSystem : public System {
 public:
+    static constexpr float GRAVITY = 700.f;
+
+    PhysicsSystem() {
+        requireComponents<Velocity>();
+        excludeComponents<ProjectileComponent>();
+        readsComponents<PlayerComponent>();
+        writesComponents<Velocity>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
         float dt = ctxt.dt;
 
-        float gravity = 700.0f;
+        float gravity = GRAVITY;
 
         for (Entity entity: entities) {
-            if (components.hasComponent<Velocity>(entity) && components.hasComponent<PlayerComponent>(entity)) {
+            if (components.hasComponent<PlayerComponent>(entity)) {
                 auto &velocity = components.getComponent<Velocity>(entity);
                 auto &player = components.getComponent<PlayerComponent>(entity);
 
                 if (player.gravityToggle) {
                     velocity.dy += gravity * dt;
                 }
-            } else if (!components.hasComponent<PlayerComponent>(entity) && components.hasComponent<Velocity>(entity)) {
+            } else {
                 auto &velocity = components.getComponent<Velocity>(entity);
                 velocity.dy += gravity * dt;
             }
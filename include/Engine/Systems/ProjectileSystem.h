@@ -7,7 +7,9 @@
 
 #include "Engine/ComponentManager.h"
 #include "Engine/EntityManager.h"
+#include "Engine/Core/CommandBuffer.h"
 #include "Engine/Core/UpdateContext.h"
+#include "Engine/Core/Log.h"
 #include "Engine/System.h"
 #include "Engine/SystemManager.h"
 #include "Engine/Components/ProjectileComponent.h"
@@ -23,43 +25,42 @@
 class ProjectileSystem : public System
 {
 public:
+     ProjectileSystem()
+     {
+          requireComponents<ProjectileComponent, Position, Velocity>();
+          readsComponents<Velocity>();
+          writesComponents<ProjectileComponent, Position>();
+     }
+
      void update(const UpdateContext&ctxt)  override
      {
           ComponentManager &components = *ctxt.component;
-          EntityManager &entityManager = *ctxt.entity;
-          SystemManager &systemManager = *ctxt.system;
           float dt = ctxt.dt;
 
           for (Entity entity: entities)
           {
-               std::cout << "PROJECTILE SYSTEM UPDATE CALL" << std::endl;
-               if (components.hasComponent<ProjectileComponent>(entity) && components.hasComponent<Position>(entity))
-               {
-                    auto &projectile = components.getComponent<ProjectileComponent>(entity);
-                    auto &velocity = components.getComponent<Velocity>(entity);
-                    auto &pos = components.getComponent<Position>(entity);
+               LOG_TRACE("Projectile update {" << entity << "}");
+               auto &projectile = components.getComponent<ProjectileComponent>(entity);
+               auto &velocity = components.getComponent<Velocity>(entity);
+               auto &pos = components.getComponent<Position>(entity);
 
-                    // May need to look into a better way to handle this
-                    // since projectiles should be able along x and y
-                    pos.x += velocity.dx * dt;
-                    pos.y += velocity.dy * dt;
+               // May need to look into a better way to handle this
+               // since projectiles should be able along x and y
+               pos.x += velocity.dx * dt;
+               pos.y += velocity.dy * dt;
 
-                    projectile.lifeTime -= dt;
+               projectile.lifeTime -= dt;
 
-                    if (projectile.lifeTime <= 0.0f)
-                    {
-                         projectile.isDestroyed = true;
-                    }
-
-                    if (projectile.isDestroyed)
-                    {
-                         std::cout << "DESTROYING PROJECTILE{" << entity << "}";
-                         entityManager.destroyEntity(entity);
-                         systemManager.entityDestroyed(entity);
-                         std::cout << "SUCCESSFUL" << std::endl;
-                    }
+               if (projectile.lifeTime <= 0.0f)
+               {
+                    projectile.isDestroyed = true;
                }
 
+               if (projectile.isDestroyed)
+               {
+                    ctxt.commands->destroy(entity);
+                    LOG_DEBUG("Destroying projectile {" << entity << "}");
+               }
           }
      }
 };
@@ -9,8 +9,11 @@
 
 #include "Engine/Components/AttackColliderComponent.h"
 #include "Engine/Components/ColliderComponent.h"
+#include "Engine/Components/EmitterComponent.h"
 #include "Engine/Components/HealthComponent.h"
 #include "Engine/Components/TileComponent.h"
+#include "Engine/Core/TileChunkMap.h"
+#include "Engine/Core/SpriteBatch.h"
 #include "ParticleSystem/HomingParticleSystem.h"
 
 /**
@@ -21,6 +24,32 @@
 
 class RenderSystem : public System {
 public:
+    RenderSystem() {
+        requireComponents<Position, SpriteComponent>();
+        excludeComponents<EmitterComponent, TileComponent>(); // Tiles are drawn from the tile map's chunks
+    }
+
+    void setTileMap(TileChunkMap *tileMap) { m_tileMap = tileMap; }
+
+    /**
+     * @brief Remembers where every sprite is before a simulation step.
+     *        update() draws sprites between that position and the current one by ctxt.alpha.
+     */
+    void storePreviousPositions(ComponentManager &components) {
+        std::vector<Entity> stale;
+        for (Entity entity: previousPositions.entities()) {
+            if (!entities.contains(entity)) stale.push_back(entity);
+        }
+        for (Entity entity: stale) {
+            previousPositions.remove(entity);
+        }
+
+        // Only sprites are members, static tiles are drawn from the tile map and never interpolated
+        for (auto [entity, pos]: components.view<Position>(entities)) {
+            previousPositions.insert(entity, pos);
+        }
+    }
+
     void update(const UpdateContext &ctxt) override {
         sf::RenderWindow &window = *ctxt.window;
         ComponentManager &components = *ctxt.component;
@@ -28,14 +57,20 @@ public:
 
         bool debugMode = false;
 
-        // First draw all tile components
-        for (auto entity: entities) {
-            if (components.hasComponent<TileComponent>(entity)) {
-                auto &pos = components.getComponent<Position>(entity);
-                auto &tile = components.getComponent<TileComponent>(entity);
-                tile.sprite.setPosition(pos.x, pos.y);
-                window.draw(tile.sprite);
+        // Anything outside the camera's view is skipped
+        sf::FloatRect visible = viewBounds(window.getView());
+        stats = {};
+
+        // First draw the tile map, one draw call per chunk and tileset
+        if (m_tileMap) {
+            m_tileMap->rebuildDirtyChunks();
+            std::size_t culledChunks = m_tileMap->drawVisible(window, visible);
+            std::size_t chunkCount = 0;
+            for (const auto &chunk: m_tileMap->getChunks()) {
+                if (!chunk.layers.empty()) ++chunkCount;
             }
+            stats.culled += culledChunks;
+            stats.drawn += chunkCount - culledChunks;
         }
 
         if (debugMode) {
@@ -79,20 +114,60 @@ public:
             }
         }
 
-        //  drawing all sprite components (like player)
-        for (auto entity: entities) {
-            if (components.hasComponent<SpriteComponent>(entity) &&
-                !components.hasComponent<TileComponent>(entity)) {
-                auto &spriteComp = components.getComponent<SpriteComponent>(entity);
-                auto &pos = components.getComponent<Position>(entity);
-                spriteComp.sprite.setPosition(pos.x, pos.y);
-                window.draw(spriteComp.sprite);
+        //  drawing all sprite components (like player), batched into one draw call per texture
+        spriteBatch.clear();
+        for (auto [entity, spriteComp, pos]: components.view<SpriteComponent, Position>(entities)) {
+            spriteComp.sprite.setPosition(interpolated(entity, pos, ctxt.alpha));
+            if (!spriteComp.sprite.getGlobalBounds().intersects(visible)) {
+                ++stats.culled;
+                continue;
             }
+            spriteBatch.add(spriteComp.sprite, spriteComp.zOrder);
+            ++stats.drawn;
         }
+        spriteBatch.draw(window);
         for (auto obj: drawables) {
+            // Particle systems are culled as a whole by the area their quads cover
+            if (auto *particles = dynamic_cast<const ParticleSystem *>(obj)) {
+                if (!particles->getBounds().intersects(visible)) {
+                    ++stats.culled;
+                    continue;
+                }
+            }
             window.draw(*obj);
+            ++stats.drawn;
         }
     }
+
+    // Counts of tile chunks, sprites and drawables drawn vs. culled during the last update.
+    struct RenderStats {
+        std::size_t drawn = 0;
+        std::size_t culled = 0;
+    };
+
+    const RenderStats &getStats() const { return stats; }
+
+    const SpriteBatch &getSpriteBatch() const { return spriteBatch; }
+
+private:
+    RenderStats stats;
+    SpriteBatch spriteBatch;
+    ComponentArray<Position> previousPositions; // Sprite positions before the last simulation step
+
+    // Entities spawned during the last step have no previous position and are drawn where they are.
+    sf::Vector2f interpolated(Entity entity, const Position &pos, float alpha) {
+        const Position *previous = previousPositions.tryGet(entity);
+        if (!previous) return {pos.x, pos.y};
+        return {previous->x + (pos.x - previous->x) * alpha, previous->y + (pos.y - previous->y) * alpha};
+    }
+
+    static sf::FloatRect viewBounds(const sf::View &view) {
+        const sf::Vector2f &center = view.getCenter();
+        const sf::Vector2f &size = view.getSize();
+        return {center.x - size.x / 2.f, center.y - size.y / 2.f, size.x, size.y};
+    }
+
+    TileChunkMap *m_tileMap = nullptr;
 };
 
 #endif
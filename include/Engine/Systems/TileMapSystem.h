@@ -1,19 +1,24 @@
 #ifndef TILEMAPSYSTEM_H
 #define TILEMAPSYSTEM_H
 
-#include <fstream>
-#include <sstream>
+#include <cstdint>
+#include <exception>
 #include <string>
-#include <iostream>
-#include <unordered_map>
+#include <vector>
 
 #include "Engine/System.h"
 #include "Engine/Core/UpdateContext.h"
+#include "Engine/Core/Log.h"
 #include "Engine/Components/TileComponent.h"
+#include "Engine/Components/ColliderComponent.h"
 #include "Engine/Components/Position.h"
 #include "Engine/EntityManager.h"
 #include "Engine/ComponentManager.h"
 #include "Engine/TilesetManager.h"
+#include "Engine/Core/CookedMap.h"
+#include "Engine/Core/MappedFile.h"
+#include "Engine/Core/TileChunkMap.h"
+#include "Engine/Systems/CollisionSystem.h"
 #include "external/json/json.hpp"
 
 class TileMapSystem : public System {
@@ -35,94 +40,145 @@ public:
         }
     }
 
+    /**
+     * @brief Loads a tile map: creates the entities of its solid tiles, builds the chunks that draw it and
+     *        hands its solidity to the collision system.
+     *        A cooked map (see CookedMap, written by the map_cooker tool) is memory-mapped and read in place.
+     *        The editor's JSON is still accepted, it is parsed and cooked in memory first.
+     */
     bool loadMap(const std::string &filename,
                  ComponentManager &components,
                  EntityManager &entityManager,
                  TilesetManager &tilesetManager,
-                 RenderSystem &renderSystem,
                  CollisionSystem &collisionSystem,
                  float tileScale = 3.0f) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open map file: " << filename << std::endl;
+        MappedFile file;
+        if (!file.open(filename)) {
+            LOG_ERROR("Failed to open map file: " << filename);
             return false;
         }
 
-        nlohmann::json j;
-        file >> j;
+        try {
+            if (CookedMap::isCooked(file.data(), file.size())) {
+                buildMap(CookedMap::View(file.data(), file.size()), components, entityManager, tilesetManager,
+                         collisionSystem, tileScale);
+                LOG_INFO("Map loaded from cooked map: " << filename);
+            } else {
+                std::vector<unsigned char> cooked = CookedMap::cook(
+                    nlohmann::json::parse(file.data(), file.data() + file.size()));
+                buildMap(CookedMap::View(cooked.data(), cooked.size()), components, entityManager, tilesetManager,
+                         collisionSystem, tileScale);
+                LOG_INFO("Map loaded from JSON: " << filename);
+            }
+        } catch (const std::exception &e) {
+            LOG_ERROR("Failed to load map " << filename << ": " << e.what());
+            return false;
+        }
+        return true;
+    }
 
-        int width = j["width"];
-        int height = j["height"];
-        const auto &tileRows = j["tiles"];
+    TileChunkMap &getTileMap() { return tileMap; }
+    const TileChunkMap &getTileMap() const { return tileMap; }
+
+    void update(const UpdateContext &ctxt) override {
+    };
+
+private:
+    TileChunkMap tileMap;
+
+    void buildMap(const CookedMap::View &map,
+                  ComponentManager &components,
+                  EntityManager &entityManager,
+                  TilesetManager &tilesetManager,
+                  CollisionSystem &collisionSystem,
+                  float tileScale) {
+        int width = map.getWidth();
+        int height = map.getHeight();
+
+        tileMap.reset(width, height, tileScale);
+        if (map.getLayerCount() > 1) {
+            LOG_WARN("Map has " << map.getLayerCount() << " layers, only the first one is loaded");
+        }
+
+        // Resolved once per tileset instead of once per tile.
+        std::vector<const Tileset *> tilesets(map.getTilesetCount(), nullptr);
+        for (std::size_t i = 0; i < tilesets.size(); ++i) {
+            std::string name(map.getTilesetName(i));
+            if (tilesetManager.hasTileset(name)) {
+                tilesets[i] = &tilesetManager.getTileset(name);
+            } else {
+                LOG_WARN("Tileset not found: " << name);
+            }
+        }
+
+        Signature tileSignature;
+        tileSignature.set(componentType<ColliderComponent>());
+        tileSignature.set(componentType<TileComponent>());
+        tileSignature.set(componentType<Position>());
+
+        // Built alongside the tile entities so isSolidAt never has to scan them.
+        SolidityGrid solidity;
 
         for (int y = 0; y < height; ++y) {
-            const auto &row = tileRows[y];
             for (int x = 0; x < width; ++x) {
-                const auto &cell = row[x];
-
-                if (cell.is_null()) continue;
+                std::uint16_t cell = map.getCell(0, x, y);
+                if (cell == CookedMap::EMPTY_CELL) continue;
 
-                std::string tilesetName = cell["sheet"];
-                int tileID = cell["id"];
+                std::size_t tileset = cell >> CookedMap::TILE_ID_BITS;
+                int tileID = cell & CookedMap::MAX_TILE_ID;
+                if (tileset >= tilesets.size() || !tilesets[tileset]) continue;
 
-                if (!tilesetManager.hasTileset(tilesetName)) {
-                    std::cerr << "Tileset not found: " << tilesetName << std::endl;
-                    continue;
+                const Tileset &ts = *tilesets[tileset];
+                if (ts.region) {
+                    tileMap.setTile(x, y, &ts, tileID);
                 }
 
-                const Tileset &ts = tilesetManager.getTileset(tilesetName);
+                // Only solid tiles need an entity, the visuals live in tileMap's chunks.
+                if (!map.isSolid(x, y)) continue;
 
                 Entity tile = entityManager.createEntity();
-                sf::Sprite sprite;
-                sprite.setTexture(ts.texture);
-
-                int tx = tileID % ts.tilesPerRow;
-                int ty = tileID / ts.tilesPerRow;
-
-                sprite.setTextureRect(sf::IntRect(
-                    tx * ts.tileWidth,
-                    ty * ts.tileHeight,
-                    ts.tileWidth,
-                    ts.tileHeight
-                ));
-                sprite.setOrigin(ts.tileWidth / 2.f, ts.tileHeight / 2.f);
-                sprite.setScale(tileScale, tileScale);
-                sprite.setPosition(x * ts.tileWidth * tileScale + ts.tileWidth / 2.f,
-                                   y * ts.tileHeight * tileScale + ts.tileHeight / 2.f);
+                sf::Vector2f center{
+                    x * ts.tileWidth * tileScale + ts.tileWidth / 2.f,
+                    y * ts.tileHeight * tileScale + ts.tileHeight / 2.f
+                };
 
                 TileComponent tileComp;
-                tileComp.type = getTileTypeFromID(tileID, tilesetName);
+                tileComp.type = getTileTypeFromID(tileID, ts.name);
                 tileComp.tileID = tileID;
-                tileComp.sprite = sprite;
-                tileComp.isSolid = (tilesetName == "grass"); // might try to pull from JSON if available later
-
-                if (tileComp.isSolid) {
-                    ColliderComponent collider;
-                    collider.bounds = {
-                        -ts.tileWidth * tileScale / 2.f,
-                        (-ts.tileHeight * tileScale / 2.f) + 10,
-                        ts.tileWidth * tileScale,
-                        (ts.tileHeight * tileScale) - 10
+                tileComp.isSolid = true;
+
+                ColliderComponent collider;
+                collider.bounds = {
+                    -ts.tileWidth * tileScale / 2.f,
+                    (-ts.tileHeight * tileScale / 2.f) + 10,
+                    ts.tileWidth * tileScale,
+                    (ts.tileHeight * tileScale) - 10
+                };
+                collider.isStatic = true;
+                collider.tag = "Tile";
+
+                if (solidity.empty()) {
+                    sf::Vector2f pitch{ts.tileWidth * tileScale, ts.tileHeight * tileScale};
+                    sf::Vector2f origin{
+                        center.x + collider.bounds.left - x * pitch.x,
+                        center.y + collider.bounds.top - y * pitch.y
                     };
-                    collider.isStatic = true;
-                    collider.tag = "Tile";
-
-                    components.addComponent<ColliderComponent>(tile, collider);
-                    collisionSystem.entities.insert(tile);
+                    solidity = SolidityGrid(width, height, origin, pitch,
+                                            {collider.bounds.width, collider.bounds.height});
                 }
+                solidity.setSolid(x, y, true);
 
-                components.addComponent<TileComponent>(tile, tileComp);
-                components.addComponent<Position>(tile, {sprite.getPosition().x, sprite.getPosition().y});
-                renderSystem.entities.insert(tile);
+                // The signature is set once, the tile joins its systems in a single pass.
+                components.insertComponent<ColliderComponent>(tile, std::move(collider));
+                components.insertComponent<TileComponent>(tile, tileComp);
+                components.insertComponent<Position>(tile, {center.x, center.y});
+                components.setSignature(tile, tileSignature);
             }
         }
 
-        std::cout << "Map loaded from JSON: " << filename << std::endl;
-        return true;
+        tileMap.rebuildDirtyChunks();
+        collisionSystem.setSolidityGrid(std::move(solidity));
     }
-
-    void update(const UpdateContext &ctxt) override {
-    };
 };
 
 #endif
\ No newline at end of file
@@ -14,6 +14,11 @@
  */
 class TriggerSystem : public System {
 public:
+    TriggerSystem() {
+        readsComponents<Position>();
+        writesComponents<ColliderComponent>();
+    }
+
     void update(const UpdateContext &ctxt) override {
         ComponentManager &components = *ctxt.component;
         float dt = ctxt.dt;
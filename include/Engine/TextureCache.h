@@ -0,0 +1,144 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Core/AtlasPacker.h"
+#include "Engine/Core/Log.h"
+
+/**
+ * @brief A texture together with the area of it that holds one image.
+ *        Images packed into an atlas share the atlas texture and differ only by rect.
+ */
+struct TextureRegion {
+    std::shared_ptr<sf::Texture> texture;
+    sf::IntRect rect;
+
+    explicit operator bool() const { return texture != nullptr; }
+};
+
+/**
+ * @brief Loads every image file at most once.
+ *        packAtlases() can be called up front to combine a set of files into a few large atlas
+ *        textures, later load() calls for those files then return their region of the atlas.
+ */
+class TextureCache {
+public:
+    static constexpr unsigned DEFAULT_ATLAS_SIZE = 4096;
+
+    /**
+     * @brief Returns the texture region for path, loading the file on first use.
+     *        Returns an empty region if the file could not be loaded.
+     */
+    TextureRegion load(const std::string &path) {
+        auto it = regions.find(path);
+        if (it != regions.end()) {
+            return it->second;
+        }
+
+        auto texture = std::make_shared<sf::Texture>();
+        if (!texture->loadFromFile(path)) {
+            LOG_ERROR("Failed to load texture: " << path);
+            return {};
+        }
+
+        sf::Vector2u size = texture->getSize();
+        TextureRegion region{texture, {0, 0, static_cast<int>(size.x), static_cast<int>(size.y)}};
+        regions.emplace(path, region);
+        return region;
+    }
+
+    bool contains(const std::string &path) const {
+        return regions.find(path) != regions.end();
+    }
+
+    /**
+     * @brief Packs the given image files into as few atlas textures as possible.
+     *        Files that are already cached, fail to load or do not fit on one page are skipped
+     *        and will be loaded on their own by load().
+     * @return The number of atlas textures created.
+     */
+    std::size_t packAtlases(const std::vector<std::string> &paths, unsigned atlasSize = DEFAULT_ATLAS_SIZE) {
+        atlasSize = std::min(atlasSize, sf::Texture::getMaximumSize());
+
+        struct Source {
+            std::string path;
+            sf::Image image;
+            std::size_t page = 0;
+            sf::Vector2u position;
+        };
+
+        std::vector<Source> sources;
+        for (const std::string &path: paths) {
+            if (contains(path)) continue;
+            if (std::any_of(sources.begin(), sources.end(), [&](const Source &s) { return s.path == path; })) {
+                continue;
+            }
+
+            Source source;
+            source.path = path;
+            if (!source.image.loadFromFile(path)) {
+                LOG_ERROR("Failed to load texture: " << path);
+                continue;
+            }
+            sources.push_back(std::move(source));
+        }
+
+        // Tallest first keeps the shelves tight.
+        std::stable_sort(sources.begin(), sources.end(), [](const Source &a, const Source &b) {
+            return a.image.getSize().y > b.image.getSize().y;
+        });
+
+        AtlasPacker packer(atlasSize);
+        std::vector<Source *> packed;
+        for (Source &source: sources) {
+            if (packer.insert(source.image.getSize(), source.page, source.position)) {
+                packed.push_back(&source);
+            }
+        }
+
+        std::vector<sf::Image> pages(packer.getPageCount());
+        for (std::size_t p = 0; p < pages.size(); ++p) {
+            sf::Vector2u used = packer.getUsedSize(p);
+            pages[p].create(used.x, used.y, sf::Color::Transparent);
+        }
+        for (Source *source: packed) {
+            pages[source->page].copy(source->image, source->position.x, source->position.y);
+        }
+
+        std::vector<std::shared_ptr<sf::Texture> > atlases;
+        for (const sf::Image &page: pages) {
+            auto texture = std::make_shared<sf::Texture>();
+            if (!texture->loadFromImage(page)) {
+                LOG_ERROR("Failed to create texture atlas");
+                texture.reset();
+            }
+            atlases.push_back(texture);
+        }
+
+        for (Source *source: packed) {
+            if (!atlases[source->page]) continue;
+
+            sf::Vector2u size = source->image.getSize();
+            regions.emplace(source->path, TextureRegion{
+                                atlases[source->page],
+                                {
+                                    static_cast<int>(source->position.x), static_cast<int>(source->position.y),
+                                    static_cast<int>(size.x), static_cast<int>(size.y)
+                                }
+                            });
+        }
+
+        return atlases.size();
+    }
+
+private:
+    std::unordered_map<std::string, TextureRegion> regions;
+};
+
+#endif
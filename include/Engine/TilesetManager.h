@@ -6,28 +6,44 @@
 #include <unordered_map>
 #include <utility>
 
+#include "Engine/TextureCache.h"
+
 struct Tileset {
     std::string name;
-    sf::Texture texture;
+    TextureRegion region; // Where the sheet lives, possibly inside a shared atlas
     int tileWidth{};
     int tileHeight{};
     int tilesPerRow{};
 
     Tileset() = default;
 
-    Tileset(std::string name, const std::string &filepath, int tileW, int tileH)
-        : name(std::move(name)), tileWidth(tileW), tileHeight(tileH) {
-        if (!texture.loadFromFile(filepath)) {
-            throw std::runtime_error("Failed to load tileset: " + filepath);
-        }
-        tilesPerRow = static_cast<int>(texture.getSize().x / tileWidth);
+    Tileset(std::string name, TextureRegion region, int tileW, int tileH)
+        : name(std::move(name)), region(std::move(region)), tileWidth(tileW), tileHeight(tileH) {
+        tilesPerRow = this->region.rect.width / tileWidth;
     }
 };
 
 class TilesetManager {
 public:
+    explicit TilesetManager(TextureCache &textureCache) : textureCache(textureCache) {
+    }
+
     void addTileset(const std::string &name, const std::string &filepath, int tileW, int tileH) {
-        tilesets.emplace(name, Tileset(name, filepath, tileW, tileH));
+        TextureRegion region = textureCache.load(filepath);
+        if (!region) {
+            throw std::runtime_error("Failed to load tileset: " + filepath);
+        }
+        addTileset(name, region, tileW, tileH);
+    }
+
+    // Tileset from a texture region that is already loaded, e.g. part of an atlas.
+    void addTileset(const std::string &name, TextureRegion region, int tileW, int tileH) {
+        tilesets.emplace(name, Tileset(name, std::move(region), tileW, tileH));
+    }
+
+    // Tileset without a texture, for headless runs: its tiles still collide but are never drawn.
+    void addTileset(const std::string &name, int tileW, int tileH) {
+        addTileset(name, TextureRegion{}, tileW, tileH);
     }
 
     const Tileset &getTileset(const std::string &name) const {
@@ -43,6 +59,7 @@ public:
     }
 
 private:
+    TextureCache &textureCache;
     std::unordered_map<std::string, Tileset> tilesets;
 };
 
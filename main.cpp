@@ -1,9 +1,49 @@
 #include <Engine/Engine.h>
 
-int main()
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Parses a tick count made of digits only, false for anything else (empty, signed, trailing text, out of range).
+static bool parseTicks(const char *text, std::size_t &ticks)
+{
+    if (!std::isdigit(static_cast<unsigned char>(text[0]))) return false;
+
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE) return false;
+    if (value > static_cast<unsigned long long>(static_cast<std::size_t>(-1))) return false;
+
+    ticks = static_cast<std::size_t>(value);
+    return true;
+}
+
+// Usage: iskobrEngine [--headless <ticks> [--profile <file prefix>]]
+int main(int argc, char *argv[])
 {
     bool debugMode = true;
     Engine engine;
+
+    if (argc > 1 && std::string(argv[1]) == "--headless")
+    {
+        bool profile = argc == 5 && std::string(argv[3]) == "--profile";
+        std::size_t ticks = 0;
+        if ((argc != 3 && !profile) || !parseTicks(argv[2], ticks))
+        {
+            std::cerr << "Usage: " << argv[0] << " --headless <ticks> [--profile <file prefix>]" << std::endl;
+            return 1;
+        }
+        engine.runHeadless(ticks);
+        if (profile)
+        {
+            engine.writeProfile(argv[4]);
+        }
+        return 0;
+    }
+
     engine.run(debugMode);
     return 0;
 }
@@ -1,8 +1,9 @@
 #include "Engine/Engine.h"
 #include <SFML/Graphics.hpp>
-#include <iostream>
+#include <filesystem>
 #include <fstream>
 
+#include "Engine/Core/Log.h"
 #include "Engine/Core/UpdateContext.h"
 #include "Engine/EntityManager.h"
 #include "Engine/ComponentManager.h"
@@ -19,26 +20,76 @@
 #include "Engine/Systems/RenderSystem.h"
 
 
+namespace {
+    constexpr int WINDOW_WIDTH = 1600;
+    constexpr int WINDOW_HEIGHT = 1200;
+}
+
 void Engine::run(bool debugMode) {
-    int WINDOW_WIDTH = 1600;
-    int WINDOW_HEIGHT = 1200;
     window.create(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "iskobr-Engine");
+    setup(false);
 
     sf::Clock clock;
+    while (window.isOpen()) {
+        float frameSeconds = clock.restart().asSeconds();
+        profiler->beginFrame();
+
+        processEvents();
+        int steps = timestep.advance(frameSeconds);
+        for (int step = 0; step < steps; ++step) {
+            renderSystem->storePreviousPositions(*componentManager);
+            update(*ctxt);
+        }
+        ctxt->alpha = timestep.getAlpha();
+        render(*ctxt, false);
+        profiler->endFrame();
+    }
+}
+
+void Engine::runHeadless(std::size_t ticks) {
+    setup(true);
+
+    sf::Clock clock;
+    for (std::size_t tick = 0; tick < ticks; ++tick) {
+        profiler->beginFrame();
+        step();
+        profiler->endFrame();
+    }
+    float seconds = clock.getElapsedTime().asSeconds();
+
+    LOG_INFO("Headless: " << ticks << " ticks in " << seconds * 1000.f << " ms ("
+             << (ticks > 0 ? seconds * 1000.f / ticks : 0.f) << " ms per tick), "
+             << entityManager->getLivingEntityCount() << " entities alive");
+}
+
+void Engine::setup(bool headless) {
+    this->headless = headless;
 
     // debug logs
     std::ofstream registryFile("../logs/system_registry.txt");
     if (!registryFile.is_open())
     {
-        std::cerr << "ERROR: could not open registry file." << std::endl;
-        return;
+        LOG_WARN("Could not open registry file");
     }
 
     //======== ECS SETUP ============
     entityManager = std::make_unique<EntityManager>();
-    componentManager = std::make_unique<ComponentManager>();
     systemManager = std::make_unique<SystemManager>();
-    tilesetManager = std::make_unique<TilesetManager>();
+    componentManager = std::make_unique<ComponentManager>(*entityManager, *systemManager);
+    textureCache = std::make_unique<TextureCache>();
+    tilesetManager = std::make_unique<TilesetManager>(*textureCache);
+    prefabManager = std::make_unique<PrefabManager>(*entityManager, *componentManager);
+
+    jobPool = std::make_unique<JobPool>();
+    commands = std::make_unique<CommandBuffer>();
+
+    // Every scheduled system gets a profiler section on its first update, render is timed by hand.
+    profiler = std::make_unique<Profiler>();
+    renderSection = profiler->addSection("Render");
+    if (!headless) {
+        profilerOverlay = std::make_unique<ProfilerOverlay>(*profiler);
+        profilerOverlay->loadFont("assets/fonts/profiler.ttf"); // Optional, the bars work without text
+    }
 
     ctxt = std::make_shared<UpdateContext>();
 
@@ -72,6 +123,41 @@ void Engine::run(bool debugMode) {
     staticFluidParticleSystem->setCollisionSystem(collisionSystem.get());
     gaseousParticleSystem->setCollisionSystem(collisionSystem.get());
 
+    // Update order. Systems that touch the same components keep this order, the rest overlap.
+    // Animation and the camera only need the frame's movement and collisions, so they are listed
+    // right after damage where they can run alongside the particle systems.
+    scheduler = std::make_unique<SystemScheduler>();
+    if (!headless) {
+        scheduler->add(inputSystem); // Polls keyboard, mouse and joystick, which need a display
+    }
+    scheduler->add(aiSystem);
+    scheduler->add(aiStateSystem);
+    scheduler->add(physicsSystem);
+    scheduler->add(movementSystem);
+    scheduler->add(knockBackSystem);
+    scheduler->add(collisionSystem);
+    scheduler->add(damageSystem);
+    scheduler->add(particleGenSystem);
+    scheduler->add(animationSystem);
+    scheduler->add(cameraSystem);
+    scheduler->add(homingParticleSystem);
+    scheduler->add(fluidParticleSystem);
+    scheduler->add(staticFluidParticleSystem);
+    scheduler->add(gaseousParticleSystem);
+    scheduler->add(emitterSystem);
+    scheduler->add(projectileSystem);
+    scheduler->add(actorSystem);
+    scheduler->add(triggerSystem);
+
+    // Component pools are created up front, systems running in parallel must not create them.
+    componentManager->registerComponents<AIComponent, ActorComponent, AnimationComponent, AttackColliderComponent,
+        ColliderComponent, DirectionComponent, EmitterComponent, HealthComponent, KnockBackComponent,
+        PlayerComponent, Position, ProjectileComponent, SpriteComponent, TileComponent, Velocity,
+        WallClingComponent>();
+
+    // The render system draws the tile map straight from the tilemap system's chunks.
+    renderSystem->setTileMap(&tileMapSystem->getTileMap());
+
     if (systemManager->getSystem<ProjectileSystem>())
     {
         registryFile << "PROJECTILE SYSTEM REGISTERED SUCCESSFULLY" << std::endl;
@@ -95,59 +181,103 @@ void Engine::run(bool debugMode) {
     particleSystems.push_back(gaseousParticleSystem);
     particleSystems.push_back(staticFluidParticleSystem);
 
+    // The particle quad texture is only needed for drawing.
+    if (!headless) {
+        for (const auto &particles: particleSystems) {
+            particles->loadTexture();
+        }
+    }
+
     auto entityFile = std::make_shared<std::string>("assets/entities.json");
+
+    struct TilesetEntry {
+        const char *name;
+        const char *path;
+    };
+    const TilesetEntry tilesets[] = {
+        {"grass", "assets/grassSheet.png"},
+        {"water", "assets/Water.png"},
+        {"dirt", "assets/dirtSheet.png"},
+        {"*water", "assets/NCWater.png"},
+    };
+
+    // Pack every animation sheet and tileset into shared atlases before anything loads them,
+    // entities and tilesets then only receive regions of those atlases from the texture cache.
+    // Headless runs load no textures at all.
+    if (!headless) {
+        std::vector<std::string> texturePaths = animationSheetPaths(*entityFile);
+        for (const auto &tileset: tilesets) {
+            texturePaths.push_back(tileset.path);
+        }
+        std::size_t atlasCount = textureCache->packAtlases(texturePaths);
+        LOG_INFO("Packed " << texturePaths.size() << " textures into " << atlasCount << " atlases");
+    }
+
     if (!loadEntities(*entityFile)) {
-        std::cerr << "PROBLEM LOADING ENTITIES" << std::endl;
+        LOG_ERROR("Problem loading entities");
     };
 
-    tilesetManager->addTileset("grass", "assets/grassSheet.png", 16, 16);
-    tilesetManager->addTileset("water", "assets/Water.png", 16, 16);
-    tilesetManager->addTileset("dirt", "assets/dirtSheet.png", 16, 16);
-    tilesetManager->addTileset("*water", "assets/NCWater.png", 16, 16);
-    tileMapSystem->loadMap("assets/maps/level.json", *componentManager, *entityManager, *tilesetManager, *renderSystem,
-                           *collisionSystem);
+    for (const auto &tileset: tilesets) {
+        if (headless) {
+            tilesetManager->addTileset(tileset.name, 16, 16);
+        } else {
+            tilesetManager->addTileset(tileset.name, tileset.path, 16, 16);
+        }
+    }
+    // The build cooks level.json into level.map. The JSON is only parsed when the cooked map is missing
+    // or older, e.g. after the level was edited without rebuilding.
+    const char *cookedMap = "assets/maps/level.map";
+    const char *sourceMap = "assets/maps/level.json";
+    std::error_code cookedError, sourceError;
+    auto cookedTime = std::filesystem::last_write_time(cookedMap, cookedError);
+    auto sourceTime = std::filesystem::last_write_time(sourceMap, sourceError);
+    bool cooked = false;
+    if (cookedError) {
+        LOG_INFO("No cooked map (" << cookedError.message() << "), parsing " << sourceMap);
+    } else if (sourceError) {
+        LOG_WARN(sourceMap << " not found (" << sourceError.message() << "), loading " << cookedMap
+                 << " without checking that it is up to date");
+        cooked = true;
+    } else if (cookedTime < sourceTime) {
+        LOG_WARN(cookedMap << " is older than " << sourceMap << ", parsing the JSON; rebuild to cook it again");
+    } else {
+        cooked = true;
+    }
+    const char *mapFile = cooked ? cookedMap : sourceMap;
+    tileMapSystem->loadMap(mapFile, *componentManager, *entityManager, *tilesetManager, *collisionSystem);
+    systemManager->sortEntities();
+
+    // Wiring update context, systems always advance by one fixed step
+    ctxt->dt = timestep.getStep();
+    ctxt->tDt = sf::seconds(ctxt->dt);
+    ctxt->component = componentManager.get();
+    ctxt->entity = entityManager.get();
+    ctxt->system = systemManager.get();
+    ctxt->window = headless ? nullptr : &window;
+    ctxt->drawables = drawables;
+    ctxt->particleSystems = particleSystems;
+    ctxt->jobs = jobPool.get();
+    ctxt->profiler = profiler.get();
+    ctxt->commands = commands.get();
+    ctxt->prefabs = prefabManager.get();
+}
 
-    while (window.isOpen()) {
-        float dt = clock.restart().asSeconds();
-        sf::Time tDt = sf::seconds(dt);
-
-        // Wiring update context
-        ctxt->tDt = tDt;
-        ctxt->dt = dt;
-        ctxt->component = componentManager.get();
-        ctxt->entity = entityManager.get();
-        ctxt->system = systemManager.get();
-        ctxt->window = &window;
-        ctxt->drawables = drawables;
-        ctxt->particleSystems = particleSystems;
+void Engine::step() {
+    update(*ctxt);
+}
 
-        processEvents();
-        update(*ctxt);
-        render(*ctxt, false);
+void Engine::writeProfile(const std::string& prefix) const {
+    if (profiler->writeCsv(prefix + ".csv") && profiler->writeChromeTrace(prefix + ".json")) {
+        LOG_INFO("Profile written to " << prefix << ".csv and " << prefix << ".json");
+    } else {
+        LOG_ERROR("Could not write profile " << prefix);
     }
 }
 
 void Engine::update(const UpdateContext& ctxt) {
-    inputSystem->update(ctxt);
-    aiSystem->update(ctxt);
-    aiStateSystem->update(ctxt);
-    physicsSystem->update(ctxt);
-    movementSystem->update(ctxt);
-    knockBackSystem->update(ctxt);
-    collisionSystem->update(ctxt);
-    animationSystem->update(ctxt);
-    damageSystem->update(ctxt);
-    particleGenSystem->update(ctxt);
-    homingParticleSystem->update(ctxt);
-    fluidParticleSystem->update(ctxt);
-    staticFluidParticleSystem->update(ctxt);
-    gaseousParticleSystem->update(ctxt);
-    emitterSystem->update(ctxt);
-    projectileSystem->update(ctxt);
-    actorSystem->update(ctxt);
-    triggerSystem->update(ctxt);
-    cameraSystem->update(ctxt);
-    window.setView(cameraSystem->view);
+    scheduler->run(ctxt);
+    // Sync point: entities spawned or destroyed by the systems this step are applied here.
+    commands->flush(*entityManager, *componentManager, *systemManager);
 }
 
 void Engine::processEvents() {
@@ -156,207 +286,58 @@ void Engine::processEvents() {
         if (event.type == sf::Event::Closed) {
             window.close();
         }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            profilerOverlay->toggle();
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+            writeProfile("profile");
+        }
     }
 }
 
 void Engine::render(UpdateContext& ctxt, bool debugMode) {
-    window.clear(sf::Color::Black); // 155, 212, 195
-    renderSystem->update(ctxt);
-    window.display();
+    {
+        ProfileScope scope(profiler.get(), renderSection);
+        window.clear(sf::Color::Black); // 155, 212, 195
+        window.setView(cameraSystem->interpolatedView(ctxt.alpha));
+        renderSystem->update(ctxt);
+
+        if (profilerOverlay->isVisible()) {
+            window.setView(window.getDefaultView());
+            window.draw(*profilerOverlay);
+        }
+    }
+    window.display(); // Left out of the render section, it waits for vsync
 }
 
-bool Engine::loadEntities(std::string &filepath) {
+std::vector<std::string> Engine::animationSheetPaths(const std::string &filepath) {
+    std::vector<std::string> paths;
     std::ifstream file(filepath);
     if (!file.is_open()) {
-        std::cerr << "Failed to open entity file: " << filepath << std::endl;
-        return false;
+        return paths;
     }
     nlohmann::json jsonArray;
     file >> jsonArray;
 
     for (const auto &j: jsonArray) {
-        Entity entity = entityManager->createEntity();
-
-        std::cout << "|------WORKING ON ENTITY: " << j["name"] << "------|\n";
-
-        if (j["name"] == "emitter") {
-            auto type = j.at("type").get<std::string>();
-            auto amount = j.at("amount").get<int>();
-            auto active = j.at("active").get<bool>();
-
-            auto& posJ = j.at("EmitterPosition");
-            float x = posJ.at("x").get<float>();
-            float y = posJ.at("y").get<float>();
-
-            componentManager->addComponent<EmitterComponent>(entity, {type, amount, active});
-            componentManager->addComponent<Position>(entity, {x, y});
-
-            emitterSystem->entities.insert(entity);
-        }
-
-        if (j["name"] == "Emitter");
-
-        if (j.contains("player") && j["player"] == true) {
-            cameraSystem->entities.insert(entity);
-            inputSystem->entities.insert(entity);
-            groundResetSystem->entities.insert(entity);
-            gaseousParticleSystem->entities.insert(entity);
-            fluidParticleSystem->entities.insert(entity);
-            homingParticleSystem->entities.insert(entity);
-            aiSystem->entities.insert(entity);
-            componentManager->addComponent<PlayerComponent>(entity,{});
-            componentManager->addComponent<WallClingComponent>(entity, {});
-            std::cout << "...Registered To Systems: cameraSystem, inputSystem, groundResetSystem\n";
-            std::cout << "...Added Component: PlayerComponent\n";
-        }
-
-        std::shared_ptr<sf::Texture> entityTexture;
-        if (j.contains("anim")) {
-            // 1) pull out the anim object
-            auto& animJ = j.at("anim");
-
-            // 2) extract its fields
-            std::string startAnim = animJ.at("start").get<std::string>();
-            int frameW         = animJ.at("frameWidth").get<int>();
-            int frameH         = animJ.at("frameHeight").get<int>();
-
-            // 3) build your AnimationComponent
-            AnimationComponent anim;
-            anim.currentState = startAnim;
-            for (auto it = j.at("spritePath").begin(); it != j.at("spritePath").end(); ++it) {
-                auto& stateJ = it.value();
-                std::string name     = stateJ.at("name").get<std::string>();
-                float frameTime      = stateJ.at("frameTime").get<float>();
-                int   frameCount     = stateJ.at("frameCount").get<int>();
-
-                auto tex = std::make_shared<sf::Texture>();
-                if (!tex->loadFromFile(stateJ.at("filePath").get<std::string>())) {
-                    std::cerr << "Failed to load: " << stateJ.at("filePath") << "\n";
-                    continue;
-                }
-
-                anim.animations[it.key()] = {
-                    .texture    = tex,
-                    .frameCount = frameCount,
-                    .frameWidth = frameW,
-                    .frameHeight= frameH,
-                    .frameTime  = frameTime
-                };
-
-                if (it.key() == startAnim)
-                    entityTexture = tex;
+        if (!j.contains("spritePath")) continue;
+        for (const auto &stateJ: j.at("spritePath")) {
+            if (stateJ.contains("filePath")) {
+                paths.push_back(stateJ.at("filePath").get<std::string>());
             }
-
-            componentManager->addComponent<AnimationComponent>(entity, {anim});
-            animationSystem->entities.insert(entity);
-        }
-        if (entityTexture) {
-            sf::Sprite entitySprite;
-            entitySprite.setTexture(*entityTexture);
-            entitySprite.setScale(3, 3);
-            entitySprite.setTextureRect(sf::IntRect(0, 0, j["anim"]["frameWidth"], j["anim"]["frameHeight"]));
-            float originX = j["anim"]["frameWidth"].get<float>() / 2.f;
-            float originY = j["anim"]["frameHeight"].get<float>() / 2.f;
-            entitySprite.setOrigin(originX, originY);
-
-            componentManager->addComponent<SpriteComponent>(entity, {entitySprite});
-            std::cout << "...Added Component: SpriteComponent\n";
-        }
-
-        if (j.contains("sprite") && j["sprite"] == true) {
-            std::string startAnim = j["anim"]["start"];
-            auto entityTexture = std::make_shared<sf::Texture>();
-            entityTexture->loadFromFile(j["spritePath"][startAnim]["filePath"]);
-
-            sf::Sprite entitySprite;
-            entitySprite.setTexture(*entityTexture);
-            entitySprite.setScale(3, 3);
-            entitySprite.setTextureRect(sf::IntRect(0, 0, 48, 64));
-            entitySprite.setOrigin(48 / 2.f, 64 / 2.f);
-        }
-        if (j.contains("actor")) {
-            componentManager->addComponent<ActorComponent>(entity, {j["actor"]["name"]});
-            actorSystem->entities.insert(entity);
-            std::cout << "...Added Component: Actor Name\n";
-            std::cout << "...Registered To System: actorSystem\n";
-        }
-        if (j.contains("Position")) {
-            componentManager->addComponent<Position>(entity, {j["Position"]["x"], j["Position"]["y"]});
-            //float x = j["Positon"]["x"].get<float>();
-            //float y = j["Position"]["y"].get<float>();
-            //std::cout << "...Added Component: PositionComponent-> with coordinates {" << x << "," << y << "}\n";
-        };
-        if (j.contains("Velocity")) {
-            componentManager->addComponent<Velocity>(entity, {j["Velocity"]["dx"], j["Velocity"]["dy"]});
-            componentManager->addComponent<KnockBackComponent>(entity, {});
-            physicsSystem->entities.insert(entity);
-            knockBackSystem->entities.insert(entity);
-            float dx = j["Velocity"]["dx"].get<float>();
-            float dy = j["Velocity"]["dy"].get<float>();
-            std::cout << "...Component Added: Velocity-> with vectors {" << dx << "," << dy << "}\n";
-            std::cout << "...Registered To System: physicsSystem\n";
-        }
-        if (j.contains("Direction") && j["Direction"] == true) {
-            componentManager->addComponent<DirectionComponent>(entity, {});
-            std::cout << "...Added Component: DirectionComponent\n";
-        }
-        if (j.contains("Collision")) {
-            ColliderComponent colCom;
-            colCom.bounds = sf::FloatRect(j["Collision"]["rectLeft"], j["Collision"]["rectTop"],
-                                          j["Collision"]["rectWidth"], j["Collision"]["rectHeight"]);
-            colCom.isStatic = j["Collision"]["isStatic"];
-
-            componentManager->addComponent<ColliderComponent>(entity, colCom);
-            collisionSystem->entities.insert(entity);
-
-            std::cout << "...Added Component: ColliderComponent-> with the following parameters...\n "
-                         "        rectLeft:" << j["Collision"]["rectLeft"] << "\n "
-                         "        rectTop:" << j["Collision"]["rectTop"] << "\n"
-                         "        rectWidth:" << j["Collision"]["rectWidth"] << "\n"
-                         "        rectHeight:" << j["Collision"]["rectHeight"] << "\n"
-                         "        isStatic:" << j["Collision"]["isStatic"] << "\n";
-            std::cout << "...Registered To System: collisionSystem\n";
-        }
-        if (j.contains("AttackCollisionRight")) {
-            AttackColliderComponent colCom;
-            // Right directional attack collision
-            colCom.boundsRight = sf::FloatRect(j["AttackCollisionRight"]["rectLeft"], j["AttackCollisionRight"]["rectTop"],
-                                          j["AttackCollisionRight"]["rectWidth"], j["AttackCollisionRight"]["rectHeight"]);
-            // Left directional attack collision
-            colCom.boundsLeft = sf::FloatRect(j["AttackCollisionLeft"]["rectLeft"], j["AttackCollisionLeft"]["rectTop"],
-                                          j["AttackCollisionLeft"]["rectWidth"], j["AttackCollisionLeft"]["rectHeight"]);
-
-            componentManager->addComponent<AttackColliderComponent>(entity, colCom);
-
-            std::cout << "...Added Component: AttackColliderComponent-> with the following parameters...\n ";
-        }
-
-        if (j.contains("Movement")) {
-            movementSystem->entities.insert(entity);
-            std::cout << "...Registered To System: movementSystem\n";
-        }
-
-        if (j.contains("health") && j["health"] == true) {
-            componentManager->addComponent<HealthComponent>(entity, {});
-            damageSystem->entities.insert(entity);
-            std::cout << "...Added Component: HealthComponent\n";
-            std::cout << "...Registered To System: damageSystem\n";
-        }
-
-        if (j["name"] != "emitter") {
-            renderSystem->entities.insert(entity);
-            std::cout << "...Registered To System: renderSystem\n";
-        }
-
-        if (j.contains("ai-sys") && j["ai-sys"] == true) {
-            componentManager->addComponent<ActorComponent>(entity, {"NPC1"});
-            componentManager->addComponent<SeekComponent>(entity, {});
-            //componentManager->addComponent<PatrolComponent>(entity, {});
-            componentManager->addComponent<AIComponent>(entity, {});
-            aiStateSystem->entities.insert(entity);
-            aiSystem->entities.insert(entity);
         }
     }
+    return paths;
+}
 
+bool Engine::loadEntities(std::string &filepath) {
+    // Every entry becomes a prefab, the level's entities are then cloned from them.
+    if (!prefabManager->loadFile(filepath, headless ? nullptr : textureCache.get())) {
+        return false;
+    }
+    for (const Prefab *prefab: prefabManager->getPlacements()) {
+        Entity entity = prefabManager->instantiate(*prefab);
+        LOG_DEBUG("Spawned " << prefab->getName() << " {" << entity << "}");
+    }
     return true;
 }
\ No newline at end of file
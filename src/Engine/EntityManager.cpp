@@ -1,26 +1,82 @@
 #include "Engine/EntityManager.h"
 
-EntityManager::EntityManager() {
-    for (Entity e = 0; e < MAX_ENTITIES; ++e) {
-        availableEntities.push(e);
-    }
-}
+#include <cassert>
 
 Entity EntityManager::createEntity() {
-    // Retrieve an available ID
-    Entity id = availableEntities.front();
-    availableEntities.pop();
+    // Retrieve a recycled ID, or mint a new one. The vector doubles its capacity as it grows.
+    Entity id = freeHead;
+    if (id != InvalidEntity) {
+        freeHead = slots[id].nextFree;
+        if (freeHead == InvalidEntity) freeTail = InvalidEntity;
+        slots[id].nextFree = InvalidEntity;
+    } else {
+        assert(slots.size() < InvalidEntity && "Out of entity IDs.");
+        id = static_cast<Entity>(slots.size());
+        slots.emplace_back();
+    }
 
     // Mark entity active
-    aliveEntities.set(id);
+    slots[id].alive = true;
+    ++livingCount;
 
     return id;
 }
 
 void EntityManager::destroyEntity(Entity entity) {
-    // Mark entity destroyed
-    aliveEntities.reset(entity);
+    assert(isAlive(entity) && "Destroying an entity that is not alive.");
+
+    // Mark entity destroyed and clear its components' signature
+    Slot &slot = slots[entity];
+    slot.alive = false;
+    slot.signature.reset();
+    ++slot.generation; // Outstanding handles to it are now stale
+    --livingCount;
+
+    // Recycle ID (append to the free list)
+    if (freeTail == InvalidEntity) {
+        freeHead = entity;
+    } else {
+        slots[freeTail].nextFree = entity;
+    }
+    freeTail = entity;
+}
+
+void EntityManager::setSignature(Entity entity, Signature signature) {
+    assert(entity < slots.size() && "Entity out of range.");
+    slots[entity].signature = signature;
+}
+
+Signature EntityManager::getSignature(Entity entity) const {
+    assert(entity < slots.size() && "Entity out of range.");
+    return slots[entity].signature;
+}
+
+bool EntityManager::isAlive(Entity entity) const {
+    return entity < slots.size() && slots[entity].alive;
+}
+
+EntityHandle EntityManager::getHandle(Entity entity) const {
+    assert(isAlive(entity) && "Handle to an entity that is not alive.");
+    return {entity, slots[entity].generation};
+}
+
+bool EntityManager::isAlive(EntityHandle handle) const {
+    return handle.index < slots.size() && slots[handle.index].alive &&
+           slots[handle.index].generation == handle.generation;
+}
+
+Entity EntityManager::resolve(EntityHandle handle) const {
+    return isAlive(handle) ? handle.index : InvalidEntity;
+}
+
+std::size_t EntityManager::getLivingEntityCount() const {
+    return livingCount;
+}
+
+std::size_t EntityManager::getIdCount() const {
+    return slots.size();
+}
 
-    // Recycle ID (push back into queue)
-    availableEntities.push(entity);
+void EntityManager::reserve(std::size_t count) {
+    slots.reserve(count);
 }
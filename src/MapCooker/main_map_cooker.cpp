@@ -0,0 +1,40 @@
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "Engine/Core/CookedMap.h"
+#include "external/json/json.hpp"
+
+// Cooks a tile map saved by the editor into the binary format the engine memory-maps:
+//     map_cooker assets/maps/level.json assets/maps/level.map
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <map.json> <map.map>\n";
+        return 1;
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in.is_open()) {
+        std::cerr << "Failed to open: " << argv[1] << "\n";
+        return 1;
+    }
+
+    std::vector<unsigned char> cooked;
+    try {
+        cooked = CookedMap::cook(nlohmann::json::parse(in));
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to cook " << argv[1] << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    std::ofstream out(argv[2], std::ios::binary);
+    out.write(reinterpret_cast<const char *>(cooked.data()), static_cast<std::streamsize>(cooked.size()));
+    if (!out) {
+        std::cerr << "Failed to write: " << argv[2] << "\n";
+        return 1;
+    }
+
+    std::cout << "Cooked " << argv[1] << " into " << argv[2] << " (" << cooked.size() << " bytes)\n";
+    return 0;
+}